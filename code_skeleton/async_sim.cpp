@@ -0,0 +1,173 @@
+#include "game/async/AsyncGameDriver.hpp"
+#include "strat/GreedyStrategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Many games on one thread behind a slow, batched decision backend.
+ *
+ *   ./async_sim [--players N] [--games N] [--in-flight K] [--rules file]
+ *               [--latency-us L] [--batch B] [--seed S]
+ *
+ * Seat 0 asks a simulated model server that answers up to B requests per
+ * round trip of L microseconds; the other seats play greedy inline. With K
+ * games in flight the server sees full batches while the scheduler thread
+ * keeps the other games moving. Requires C++20 (coroutines).
+ */
+
+namespace {
+
+// Stand-in for an out-of-process model: one worker thread, batched round trips
+class BatchedModelSource : public DecisionSource {
+public:
+    BatchedModelSource(std::chrono::microseconds latency, size_t maxBatch)
+        : latency(latency), max_batch(maxBatch), worker([this]() { serve(); }) {}
+
+    ~BatchedModelSource() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_one();
+        worker.join();
+    }
+
+    void request(DecisionRequest& request) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(&request);
+        }
+        cv.notify_one();
+    }
+
+    uint64_t batches() const { return batch_count; }
+    uint64_t decisions() const { return decision_count; }
+
+private:
+    std::chrono::microseconds latency;
+    size_t max_batch;
+    GreedyStrategy model;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<DecisionRequest*> pending;
+    bool stopping = false;
+    std::atomic<uint64_t> batch_count{0};
+    std::atomic<uint64_t> decision_count{0};
+    std::thread worker;
+
+    void serve() {
+        std::vector<DecisionRequest*> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this]() { return stopping || !pending.empty(); });
+                if (pending.empty()) return;
+                while (!pending.empty() && batch.size() < max_batch) {
+                    batch.push_back(pending.front());
+                    pending.pop_front();
+                }
+            }
+            std::this_thread::sleep_for(latency);  // The round trip
+            batch_count++;
+            decision_count += batch.size();
+            for (DecisionRequest* request : batch) {
+                request->complete(model.selectCardToPlay(*request->validMoves, *request->tableLayout));
+            }
+            batch.clear();
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t numPlayers = 4;
+    uint64_t games = 10000;
+    uint64_t inFlight = 1000;
+    uint64_t latencyUs = 200;
+    uint64_t maxBatch = 256;
+    uint64_t seed = 0;
+    std::string rulesPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--games") games = std::stoull(argv[++i]);
+            else if (arg == "--in-flight") inFlight = std::stoull(argv[++i]);
+            else if (arg == "--latency-us") latencyUs = std::stoull(argv[++i]);
+            else if (arg == "--batch") maxBatch = std::stoull(argv[++i]);
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        MyGameMapper prototype;
+        prototype.read_cards("");
+        prototype.read_game(rulesPath);
+        prototype.getRules().validate(numPlayers);
+        if (maxBatch == 0) {
+            // The model worker would never take a request off its queue
+            throw std::invalid_argument("--batch must be at least 1");
+        }
+
+        BatchedModelSource model(std::chrono::microseconds(latencyUs), maxBatch);
+        StrategySource greedy(std::make_shared<GreedyStrategy>());
+        std::vector<DecisionSource*> seats(numPlayers, &greedy);
+        seats[0] = &model;
+
+        GameScheduler scheduler(prototype);
+        scheduler.setSeats(seats);
+
+        std::vector<uint64_t> wins(numPlayers, 0);
+        std::vector<uint64_t> rankSum(numPlayers, 0);
+        auto start = std::chrono::steady_clock::now();
+        scheduler.run(numPlayers, games, seed, inFlight, [&](const AsyncGameResult& result) {
+            for (const auto& ranking : result.rankings) {
+                rankSum[ranking.first] += ranking.second;
+                if (ranking.second == 1) wins[ranking.first]++;
+            }
+        });
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "\n=== Async results: " << games << " games, " << inFlight << " in flight, "
+                  << static_cast<uint64_t>(games / (seconds > 0 ? seconds : 1)) << " games/sec ===\n";
+        std::cout << "Model: " << model.decisions() << " decisions in " << model.batches() << " round trips ("
+                  << (model.batches() ? static_cast<double>(model.decisions()) / model.batches() : 0.0)
+                  << " per batch)\n";
+        for (uint64_t seat = 0; seat < numPlayers; seat++) {
+            std::cout << "Seat " << seat << " (" << (seat == 0 ? "model" : "greedy") << "): win rate "
+                      << static_cast<double>(wins[seat]) / games << ", average rank "
+                      << static_cast<double>(rankSum[seat]) / games << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[async_sim] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+#include "game/async/AsyncGameDriver.hpp"
+#include "game/mapper/MyGameMapper.hpp"
+#include "game/metrics/MetricsExporter.hpp"
+#include "game/metrics/RunMetrics.hpp"
+#include "game/results/ResultsFile.hpp"
+#include "strat/RandomStrategy.hpp"
+#include "strat/GreedyStrategy.hpp"
+#include "strat/RLStrategy.hpp"
+#include "strat/NeuralStrategy.hpp"
+#include "strat/MCTSStrategy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Batch simulator: plays many quiet games and reports per-seat results.
+ *
+ *   ./batch_sim [--players N] [--games N] [--deals file] [--rules file]
+ *               [--seats random,greedy,rl:model.dat,nn:weights.bin,mcts:ms,...] [--book file]
+ *               [--in-flight K] [--metrics-file path] [--metrics-port P] [--metrics-every S]
+ *               [--results file.results]
+ *
+ * With --deals every game replays the next predefined deal, so runs on
+ * different machines see exactly the same hands.
+ *
+ * With --in-flight K the games are interleaved on the coroutine scheduler
+ * and each seat's strategy decides the pending positions of all K games in
+ * one selectCardsBatch() call. Batched seats get no observations or
+ * lifecycle calls, since one strategy object serves every game.
+ *
+ * With --metrics-file or --metrics-port the run exports Prometheus metrics
+ * (see RunMetrics): per-strategy win rates with rolling windows, decision
+ * latency and games/sec, written every --metrics-every seconds (default 10)
+ * and/or served at http://127.0.0.1:P/metrics.
+ *
+ * With --results every game is appended to a columnar results file (see
+ * ResultsFile; inspect it with results_tool): seed, game length, and per
+ * seat the strategy, rank, cards left, passes and decision time. Decision
+ * time is only measured without --in-flight.
+ *
+ * mcts seats search for the given milliseconds per decision (default 100)
+ * on every core, with the table's rules. They need the engine's
+ * observations, so under --in-flight they play the greedy order instead.
+ */
+
+static std::shared_ptr<PlayerStrategy> makeStrategy(const std::string& spec,
+                                                    const std::shared_ptr<const OpeningBook>& book,
+                                                    const GameRules& rules) {
+    if (spec == "random") return std::make_shared<RandomStrategy>();
+    if (spec == "greedy") return std::make_shared<GreedyStrategy>();
+    if (spec.rfind("rl", 0) == 0) {
+        auto rl = std::make_shared<RLStrategy>();
+        if (spec.size() > 3 && spec[2] == ':') rl->loadModel(spec.substr(3));
+        if (book) rl->setOpeningBook(book, rules);
+        return rl;
+    }
+    if (spec.rfind("nn", 0) == 0) {
+        const std::string weights = spec.size() > 3 && spec[2] == ':' ? spec.substr(3) : "neural.bin";
+        return std::make_shared<NeuralStrategy>(std::make_shared<PolicyValueNet>(weights), rules);
+    }
+    if (spec.rfind("mcts", 0) == 0) {
+        MCTSConfig config;
+        if (spec.size() > 5 && spec[4] == ':') config.moveMillis = std::stoull(spec.substr(5));
+        return std::make_shared<MCTSStrategy>(config, rules);
+    }
+    throw std::invalid_argument("Unknown strategy: " + spec);
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t numPlayers = 4;
+    uint64_t games = 10000;
+    bool gamesGiven = false;
+    std::string dealsPath;
+    std::string rulesPath;
+    std::string seatsSpec = "greedy,random,random,random";
+    std::string bookPath;
+    uint64_t inFlight = 0;
+    std::string metricsFile;
+    int metricsPort = -1;
+    uint64_t metricsEvery = 10;
+    std::string resultsPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--games") { games = std::stoull(argv[++i]); gamesGiven = true; }
+            else if (arg == "--deals") dealsPath = argv[++i];
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else if (arg == "--seats") seatsSpec = argv[++i];
+            else if (arg == "--book") bookPath = argv[++i];
+            else if (arg == "--in-flight") inFlight = std::stoull(argv[++i]);
+            else if (arg == "--metrics-file") metricsFile = argv[++i];
+            else if (arg == "--metrics-port") metricsPort = std::stoi(argv[++i]);
+            else if (arg == "--metrics-every") metricsEvery = std::stoull(argv[++i]);
+            else if (arg == "--results") resultsPath = argv[++i];
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        MyGameMapper mapper;
+        mapper.read_cards(dealsPath);
+        mapper.read_game(rulesPath);
+
+        if (!dealsPath.empty()) {
+            uint64_t dealCount = mapper.getDealCount();
+            if (!gamesGiven || games > dealCount) games = dealCount;
+        }
+        if (games == 0) {
+            // Every win rate and average rank would divide by zero
+            throw std::invalid_argument("--games must be at least 1");
+        }
+
+        // Seat strategies; the list is repeated if shorter than the table
+        std::vector<std::string> specs;
+        std::stringstream list(seatsSpec);
+        std::string spec;
+        while (std::getline(list, spec, ',')) {
+            if (spec.empty()) throw std::invalid_argument("--seats has an empty seat: " + seatsSpec);
+            specs.push_back(spec);
+        }
+        if (specs.empty()) throw std::invalid_argument("--seats needs at least one strategy");
+
+        std::shared_ptr<const OpeningBook> book;
+        if (!bookPath.empty()) book = std::make_shared<OpeningBook>(bookPath);
+
+        // Metrics are opt-in: timing every decision is not free
+        MetricsRegistry registry;
+        std::unique_ptr<RunMetrics> metrics;
+        std::unique_ptr<MetricsExporter> exporter;
+        if (!metricsFile.empty() || metricsPort >= 0) {
+            metrics = std::make_unique<RunMetrics>(registry);
+            exporter = std::make_unique<MetricsExporter>(
+                registry, metricsFile, std::chrono::seconds(std::max<uint64_t>(metricsEvery, 1)), metricsPort);
+        }
+
+        std::vector<std::string> names;
+        std::vector<std::shared_ptr<PlayerStrategy>> strategies;
+        std::vector<RunMetrics::StrategyMetrics*> seatMetrics;
+        for (uint64_t seat = 0; seat < numPlayers; seat++) {
+            const std::string& seatSpec = specs[seat % specs.size()];
+            strategies.push_back(makeStrategy(seatSpec, book, mapper.getRules()));
+            names.push_back(seatSpec);
+            if (metrics) {
+                seatMetrics.push_back(&metrics->strategy(seatSpec));
+                strategies.back() = std::make_shared<TimedStrategy>(strategies.back(), seatMetrics.back()->decisions);
+            }
+        }
+
+        // Results files name each distinct spec once and refer to it by index
+        std::unique_ptr<ResultsWriter> resultsWriter;
+        GameRecord gameRecord;
+        if (!resultsPath.empty()) {
+            std::vector<std::string> distinct;
+            gameRecord.seats.resize(numPlayers);
+            for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                auto it = std::find(distinct.begin(), distinct.end(), names[seat]);
+                gameRecord.seats[seat].strategy = it - distinct.begin();
+                if (it == distinct.end()) distinct.push_back(names[seat]);
+            }
+            resultsWriter = std::make_unique<ResultsWriter>(resultsPath, numPlayers, distinct);
+            mapper.setDecisionTiming(true);
+        }
+
+        std::vector<uint64_t> wins(numPlayers, 0);
+        std::vector<uint64_t> rankSum(numPlayers, 0);
+        auto record = [&](const std::vector<std::pair<uint64_t, uint64_t>>& results, const GameStats& stats) {
+            for (const auto& result : results) {
+                rankSum[result.first] += result.second;
+                if (result.second == 1) wins[result.first]++;
+                if (metrics) seatMetrics[result.first]->record(result.second);
+            }
+            if (metrics) metrics->gameFinished();
+            if (resultsWriter) {
+                gameRecord.seed = stats.dealSeed;
+                gameRecord.turns = stats.turns;
+                gameRecord.rounds = stats.rounds;
+                for (const auto& result : results) {
+                    SeatResult& seat = gameRecord.seats[result.first];
+                    seat.rank = result.second;
+                    seat.cardsLeft = stats.cardsLeft[result.first];
+                    seat.passes = stats.passes[result.first];
+                    seat.decisions = stats.decisions[result.first];
+                    seat.decisionNanos = stats.decisionNanos[result.first];
+                }
+                resultsWriter->append(gameRecord);
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        if (inFlight > 0) {
+            std::vector<std::unique_ptr<BatchStrategySource>> sources;
+            std::vector<DecisionSource*> seats;
+            for (const auto& strategy : strategies) {
+                sources.push_back(std::make_unique<BatchStrategySource>(strategy));
+                seats.push_back(sources.back().get());
+            }
+            GameScheduler scheduler(mapper);
+            scheduler.setSeats(seats);
+            scheduler.setReplayDeals(!dealsPath.empty());
+            scheduler.run(numPlayers, games, 0, inFlight,
+                          [&](const AsyncGameResult& result) { record(result.rankings, result.stats); });
+        } else {
+            for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                mapper.registerStrategy(seat, strategies[seat]);
+            }
+            for (uint64_t game = 0; game < games; game++) {
+                if (!dealsPath.empty()) mapper.useDeal(game);
+                const auto results = mapper.compute_game_progress(numPlayers);
+                record(results, mapper.getLastGameStats());
+            }
+        }
+        if (resultsWriter) resultsWriter->close();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "\n=== Batch results: " << games << " games, "
+                  << static_cast<uint64_t>(games / (seconds > 0 ? seconds : 1)) << " games/sec ===\n";
+        for (uint64_t seat = 0; seat < numPlayers; seat++) {
+            std::cout << "Seat " << seat << " (" << names[seat] << "): win rate "
+                      << static_cast<double>(wins[seat]) / games << ", average rank "
+                      << static_cast<double>(rankSum[seat]) / games << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[batch_sim] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
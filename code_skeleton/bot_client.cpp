@@ -0,0 +1,208 @@
+#include "game/server/Protocol.hpp"
+#include "strat/GreedyStrategy.hpp"
+#include "strat/RandomStrategy.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace sevens;
+
+/**
+ * Example bot for game_server: plays every seat the server hands it with a
+ * built-in strategy, one instance per (game, seat).
+ *
+ *   ./bot_client [--unix path | --tcp port] [--strategy greedy|random] [--name N]
+ *
+ * The loop reads everything the server has sent, answers each Turn, and
+ * writes all the answers in one go before blocking again. It keeps each
+ * seat's table from the Deal and Moved messages, the same way the engine
+ * does. It exits when the server hangs up.
+ */
+
+namespace {
+
+typedef std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>> TableLayout;
+
+// One seat of one game
+struct SeatState {
+    std::unique_ptr<PlayerStrategy> strategy;
+    TableLayout table;
+};
+
+int connectTo(const std::string& unixPath, int tcpPort) {
+    int fd;
+    if (tcpPort >= 0) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(tcpPort));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        int one = 1;
+        if (fd >= 0) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    } else {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, unixPath.c_str(), sizeof(address.sun_path) - 1);
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0) {
+        throw std::runtime_error("Could not connect to the server: " + std::string(std::strerror(errno)));
+    }
+    return fd;
+}
+
+void sendAll(int fd, std::string& out) {
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t n = ::send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw std::runtime_error("Lost the server: " + std::string(std::strerror(errno)));
+        sent += static_cast<size_t>(n);
+    }
+    out.clear();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string unixPath = "sevens.sock";
+    int tcpPort = -1;
+    std::string strategyName = "greedy";
+    std::string name = "bot_client";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        if (arg == "--unix") unixPath = argv[++i];
+        else if (arg == "--tcp") tcpPort = std::stoi(argv[++i]);
+        else if (arg == "--strategy") strategyName = argv[++i];
+        else if (arg == "--name") name = argv[++i];
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        if (strategyName != "greedy" && strategyName != "random") {
+            throw std::invalid_argument("Unknown strategy: " + strategyName);
+        }
+        const int fd = connectTo(unixPath, tcpPort);
+
+        std::string out;
+        FrameWriter(out, MessageType::Hello).u16(kProtocolVersion).text(name).finish();
+        sendAll(fd, out);
+
+        std::unordered_map<uint64_t, SeatState> seats;  // game << 8 | seat
+        uint64_t games = 0;
+        uint64_t wins = 0;
+        uint64_t rankSum = 0;
+        uint64_t decisions = 0;
+
+        std::string in;
+        char chunk[65536];
+        while (true) {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            in.append(chunk, static_cast<size_t>(n));
+
+            size_t offset = 0;
+            MessageType type;
+            const char* payload;
+            size_t size;
+            while (size_t used = peekFrame(in, offset, type, payload, size)) {
+                offset += used;
+                FrameReader reader(payload, size);
+                if (type == MessageType::Welcome) {
+                    std::cout << "Connected as client " << reader.u32() << std::endl;
+                    continue;
+                }
+                if (type == MessageType::Error) {
+                    std::cerr << "[bot_client] Server says: " << reader.rest() << "\n";
+                    continue;
+                }
+
+                const uint64_t game = reader.u64();
+                const uint8_t seat = reader.u8();
+                const uint64_t key = game << 8 | seat;
+                if (type == MessageType::Deal) {
+                    GameStartInfo info;
+                    info.seat = seat;
+                    info.numPlayers = reader.u8();
+                    info.numDecks = reader.u8();
+                    info.dealSeed = reader.u64();
+                    for (uint64_t p = 0; p < info.numPlayers; p++) info.handSizes.push_back(reader.u16());
+                    info.tableCards = reader.cards();
+                    info.hand = reader.cards();
+
+                    SeatState& state = seats[key];
+                    if (strategyName == "greedy") state.strategy = std::make_unique<GreedyStrategy>();
+                    else state.strategy = std::make_unique<RandomStrategy>();
+                    for (int suit = 0; suit < 4; suit++) {
+                        for (int rank = 1; rank <= 13; rank++) state.table[suit][rank] = false;
+                    }
+                    for (const Card& card : info.tableCards) state.table[card.suit][card.rank] = true;
+                    state.strategy->onGameStart(info);
+                } else if (type == MessageType::Turn) {
+                    const std::vector<Card> moves = reader.cards();
+                    SeatState& state = seats.at(key);
+                    const int index = state.strategy->selectCardToPlay(moves, state.table);
+                    FrameWriter(out, MessageType::Move).u64(game).u8(seat).u16(static_cast<uint16_t>(index)).finish();
+                    decisions++;
+                } else if (type == MessageType::Moved) {
+                    const uint8_t player = reader.u8();
+                    const Card card = reader.card();
+                    SeatState& state = seats.at(key);
+                    state.table[card.suit][card.rank] = true;
+                    state.strategy->observeMove(player, card);
+                } else if (type == MessageType::Passed) {
+                    seats.at(key).strategy->observePass(reader.u8());
+                } else if (type == MessageType::Result) {
+                    const uint8_t rank = reader.u8();
+                    seats.at(key).strategy->onGameEnd(rank);
+                    seats.erase(key);
+                    games++;
+                    rankSum += rank;
+                    if (rank == 1) wins++;
+                }
+            }
+            in.erase(0, offset);
+            if (!out.empty()) sendAll(fd, out);
+        }
+        ::close(fd);
+
+        std::cout << "Played " << games << " seats, " << decisions << " decisions, win rate "
+                  << (games ? static_cast<double>(wins) / games : 0.0) << ", average rank "
+                  << (games ? static_cast<double>(rankSum) / games : 0.0) << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[bot_client] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,249 @@
+#include "DealFile.hpp"
+#include "MyCardParser.hpp"
+#include "PackedCard.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sevens {
+
+namespace {
+
+constexpr size_t kHeaderSize = 24;
+
+// magic[4] version:u16 players:u8 reserved:u8 cards:u32 count:u64 reserved:u32
+void encodeHeader(uint8_t* out, uint64_t numPlayers, uint64_t cardsPerDeal, uint64_t dealCount) {
+    std::memset(out, 0, kHeaderSize);
+    std::memcpy(out, DealFile::kMagic, 4);
+    out[4] = static_cast<uint8_t>(DealFile::kVersion & 0xFF);
+    out[5] = static_cast<uint8_t>(DealFile::kVersion >> 8);
+    out[6] = static_cast<uint8_t>(numPlayers);
+    for (int i = 0; i < 4; i++) out[8 + i] = static_cast<uint8_t>(cardsPerDeal >> (8 * i));
+    for (int i = 0; i < 8; i++) out[12 + i] = static_cast<uint8_t>(dealCount >> (8 * i));
+}
+
+uint64_t readLE(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+} // namespace
+
+DealFile::DealFile(const std::string& path) : file_path(path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open deal file: " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not stat deal file: " + path);
+    }
+
+    char magic[4] = {0, 0, 0, 0};
+    ssize_t got = ::read(fd, magic, sizeof(magic));
+    bool binary = (got == 4 && std::memcmp(magic, kMagic, 4) == 0);
+
+    try {
+        if (binary) {
+            openBinary(fd, static_cast<size_t>(info.st_size));
+        }
+    } catch (...) {
+        ::close(fd);
+        if (mapping) {
+            ::munmap(mapping, mapping_size);
+        }
+        throw;
+    }
+    ::close(fd);
+
+    if (!binary) {
+        parseText(path);
+    }
+}
+
+DealFile::~DealFile() {
+    if (mapping) {
+        ::munmap(mapping, mapping_size);
+    }
+}
+
+void DealFile::openBinary(int fd, size_t fileSize) {
+    if (fileSize < kHeaderSize) {
+        throw std::runtime_error("Truncated deal file header: " + file_path);
+    }
+
+    mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Could not map deal file: " + file_path);
+    }
+    mapping_size = fileSize;
+    ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(mapping);
+    if (readLE(bytes + 4, 2) != kVersion) {
+        throw std::runtime_error("Unsupported deal file version: " + file_path);
+    }
+    num_players = bytes[6];
+    cards_per_deal = readLE(bytes + 8, 4);
+    deal_count = readLE(bytes + 12, 8);
+    record_size = num_players + cards_per_deal;
+
+    // Divide rather than multiply so a huge count cannot wrap past the size check
+    if (num_players == 0 || deal_count > (fileSize - kHeaderSize) / record_size) {
+        throw std::runtime_error("Corrupt or truncated deal file: " + file_path);
+    }
+    records = bytes + kHeaderSize;
+}
+
+void DealFile::parseText(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open deal file: " + path);
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    std::vector<uint8_t> sizes;
+    std::vector<uint8_t> cards;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        sizes.clear();
+        cards.clear();
+        std::istringstream hands(line);
+        std::string hand;
+        while (std::getline(hands, hand, '|')) {
+            std::istringstream tokens(hand);
+            std::string token;
+            uint8_t count = 0;
+            while (tokens >> token) {
+                Card card;
+                try {
+                    card = MyCardParser::parse_card(token);
+                } catch (const std::invalid_argument& e) {
+                    throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + e.what());
+                }
+                cards.push_back(PackedCard(card).id);
+                count++;
+            }
+            sizes.push_back(count);
+        }
+
+        if (deal_count == 0) {
+            num_players = sizes.size();
+            cards_per_deal = cards.size();
+            record_size = num_players + cards_per_deal;
+        } else if (sizes.size() != num_players || cards.size() != cards_per_deal) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) +
+                                     ": every deal must have the same seats and card count");
+        }
+        text_records.insert(text_records.end(), sizes.begin(), sizes.end());
+        text_records.insert(text_records.end(), cards.begin(), cards.end());
+        deal_count++;
+    }
+    records = text_records.data();
+}
+
+void DealFile::get(uint64_t index, Deal& out) const {
+    if (index >= deal_count) {
+        throw std::out_of_range("Deal index out of range");
+    }
+    const uint8_t* record = records + index * record_size;
+    const uint8_t* card = record + num_players;
+
+    // Records are checked as they are read, so a bad file cannot send us past the mapping
+    uint64_t total = 0;
+    for (uint64_t seat = 0; seat < num_players; seat++) total += record[seat];
+    if (total != cards_per_deal) {
+        throw std::runtime_error("Corrupt deal " + std::to_string(index) + " in " + file_path +
+                                 ": hand sizes do not add up to " + std::to_string(cards_per_deal) + " cards");
+    }
+    for (uint64_t i = 0; i < cards_per_deal; i++) {
+        if (card[i] >= PackedCard::kCount) {
+            throw std::runtime_error("Corrupt deal " + std::to_string(index) + " in " + file_path +
+                                     ": invalid card ID " + std::to_string(card[i]));
+        }
+    }
+
+    out.hands.resize(num_players);
+    for (uint64_t seat = 0; seat < num_players; seat++) {
+        auto& hand = out.hands[seat];
+        hand.clear();
+        for (uint8_t i = 0; i < record[seat]; i++, card++) {
+            hand.push_back(PackedCard(*card).card());
+        }
+    }
+}
+
+DealFileWriter::DealFileWriter(const std::string& path, uint64_t numPlayers, uint64_t cardsPerDeal)
+    : file(path, std::ios::binary | std::ios::trunc),
+      num_players(numPlayers),
+      cards_per_deal(cardsPerDeal)
+{
+    if (!file) {
+        throw std::runtime_error("Could not create deal file: " + path);
+    }
+    uint8_t header[kHeaderSize];
+    encodeHeader(header, num_players, cards_per_deal, 0);
+    file.write(reinterpret_cast<const char*>(header), kHeaderSize);
+    record.reserve(num_players + cards_per_deal);
+}
+
+DealFileWriter::~DealFileWriter() {
+    if (file.is_open()) {
+        try {
+            close();
+        } catch (const std::exception& e) {
+            std::cerr << "[DealFileWriter] " << e.what() << std::endl;
+        }
+    }
+}
+
+void DealFileWriter::write(const Deal& deal) {
+    if (deal.hands.size() != num_players) {
+        throw std::invalid_argument("Deal has the wrong number of seats");
+    }
+    record.clear();
+    size_t total = 0;
+    for (const auto& hand : deal.hands) {
+        record.push_back(static_cast<uint8_t>(hand.size()));
+        total += hand.size();
+    }
+    if (total != cards_per_deal) {
+        throw std::invalid_argument("Deal has the wrong number of cards");
+    }
+    for (const auto& hand : deal.hands) {
+        for (const Card& card : hand) {
+            record.push_back(PackedCard(card).id);
+        }
+    }
+    file.write(reinterpret_cast<const char*>(record.data()), record.size());
+    deal_count++;
+}
+
+void DealFileWriter::close() {
+    uint8_t header[kHeaderSize];
+    encodeHeader(header, num_players, cards_per_deal, deal_count);
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(header), kHeaderSize);
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Failed to write deal file");
+    }
+}
+
+} // namespace sevens
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Generic_card_parser.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * One predefined deal: the cards each seat starts with, indexed by seat.
+ */
+struct Deal {
+    std::vector<std::vector<Card>> hands;
+};
+
+/**
+ * Read-only set of predefined deals, for benchmarks that must replay the
+ * exact same deals across runs and machines.
+ *
+ * Two on-disk formats are accepted:
+ *   - binary (.deals): a 24-byte header followed by fixed-size records,
+ *     memory-mapped so files with millions of deals open instantly and are
+ *     paged in on demand. Each record is numPlayers hand sizes followed by
+ *     the card IDs (0..51) of every hand in seat order, one byte each.
+ *   - text: one deal per line, hands separated by '|', cards in the short
+ *     notation of MyCardParser::parse_card ("7D 10S AH | KC ..."); lines
+ *     starting with '#' are comments. Every line must have the same number
+ *     of seats and cards.
+ *
+ * All integers are little-endian. Throws std::runtime_error on bad files.
+ */
+class DealFile {
+public:
+    static constexpr char kMagic[4] = {'S', 'V', 'D', 'L'};
+    static constexpr uint16_t kVersion = 1;
+
+    explicit DealFile(const std::string& path);
+    ~DealFile();
+
+    DealFile(const DealFile&) = delete;
+    DealFile& operator=(const DealFile&) = delete;
+
+    uint64_t size() const { return deal_count; }
+    uint64_t numPlayers() const { return num_players; }
+    uint64_t cardsPerDeal() const { return cards_per_deal; }
+    const std::string& path() const { return file_path; }
+
+    // Decode deal `index` into out (reuses out's storage); throws on a corrupt record
+    void get(uint64_t index, Deal& out) const;
+
+private:
+    std::string file_path;
+    uint64_t num_players = 0;
+    uint64_t cards_per_deal = 0;
+    uint64_t deal_count = 0;
+    uint64_t record_size = 0;
+
+    const uint8_t* records = nullptr;   // Points into the mapping or text_records
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+    std::vector<uint8_t> text_records;  // Backing store for text files
+
+    void openBinary(int fd, size_t fileSize);
+    void parseText(const std::string& path);
+};
+
+/**
+ * Streams deals into the binary format read by DealFile.
+ */
+class DealFileWriter {
+public:
+    DealFileWriter(const std::string& path, uint64_t numPlayers, uint64_t cardsPerDeal);
+    ~DealFileWriter();
+
+    void write(const Deal& deal);
+
+    // Patches the deal count into the header and flushes; called by the destructor
+    void close();
+
+private:
+    std::ofstream file;
+    uint64_t num_players;
+    uint64_t cards_per_deal;
+    uint64_t deal_count = 0;
+    std::vector<uint8_t> record;
+};
+
+} // namespace sevens
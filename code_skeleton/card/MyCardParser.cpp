@@ -1,10 +1,21 @@
 #include "MyCardParser.hpp"
+#include "PackedCard.hpp"
 #include <iostream>
+#include <cctype>
+#include <stdexcept>
 
 namespace sevens {
 
 void MyCardParser::read_cards(const std::string& filename) {
     this->cards_hashmap.clear();
+    this->deals.reset();
+
+    // A filename selects a set of predefined deals over the standard deck
+    if (!filename.empty()) {
+        this->deals = std::make_shared<const DealFile>(filename);
+        std::cout << "Loaded " << this->deals->size() << " deal(s) for "
+                  << this->deals->numPlayers() << " players from " << filename << std::endl;
+    }
 
     for (int suit = 0; suit <= 3; suit++) {
         for (int rank = 1; rank <= 13; rank++) {
@@ -14,9 +25,11 @@ void MyCardParser::read_cards(const std::string& filename) {
             Card card{suit, rank};
             this->cards_hashmap[cardId] = card;
             
-            std::cout << "Added card ID " << cardId 
-                      << ": Suit=" << suit 
-                      << ", Rank=" << rank << std::endl;
+            if (!this->deals) {
+                std::cout << "Added card ID " << cardId 
+                          << ": Suit=" << suit 
+                          << ", Rank=" << rank << std::endl;
+            }
         }
     }
 
@@ -24,4 +37,69 @@ void MyCardParser::read_cards(const std::string& filename) {
               << " cards in total." << std::endl;
 }
 
-}
\ No newline at end of file
+Card MyCardParser::parse_card(const std::string& token) {
+    if (token.empty()) {
+        throw std::invalid_argument("Empty card token");
+    }
+
+    // Plain card ID (0..51)
+    bool numeric = true;
+    for (char c : token) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) numeric = false;
+    }
+    if (numeric) {
+        int cardId;
+        try {
+            cardId = std::stoi(token);
+        } catch (const std::out_of_range&) {
+            throw std::invalid_argument("Card ID out of range: " + token);
+        }
+        if (cardId < 0 || cardId > 51) {
+            throw std::invalid_argument("Card ID out of range: " + token);
+        }
+        return PackedCard(static_cast<uint8_t>(cardId)).card();
+    }
+
+    const std::string rankPart = token.substr(0, token.size() - 1);
+    const char suitChar = static_cast<char>(std::toupper(static_cast<unsigned char>(token.back())));
+
+    int suit;
+    switch (suitChar) {
+        case 'C': suit = 0; break;
+        case 'D': suit = 1; break;
+        case 'H': suit = 2; break;
+        case 'S': suit = 3; break;
+        default: throw std::invalid_argument("Unknown suit in card: " + token);
+    }
+
+    int rank = 0;
+    if (rankPart.size() == 1) {
+        switch (std::toupper(static_cast<unsigned char>(rankPart[0]))) {
+            case 'A': rank = 1; break;
+            case 'T': rank = 10; break;
+            case 'J': rank = 11; break;
+            case 'Q': rank = 12; break;
+            case 'K': rank = 13; break;
+            default:
+                if (std::isdigit(static_cast<unsigned char>(rankPart[0]))) rank = rankPart[0] - '0';
+        }
+    } else if (rankPart == "10") {
+        rank = 10;
+    }
+    if (rank < 1 || rank > 13) {
+        throw std::invalid_argument("Unknown rank in card: " + token);
+    }
+    return Card{suit, rank};
+}
+
+std::string MyCardParser::card_to_string(const Card& card) {
+    static const char* ranks[] = {"?", "A", "2", "3", "4", "5", "6", "7",
+                                  "8", "9", "10", "J", "Q", "K"};
+    static const char suits[] = {'C', 'D', 'H', 'S'};
+    if (card.rank < 1 || card.rank > 13 || card.suit < 0 || card.suit > 3) {
+        return "??";
+    }
+    return std::string(ranks[card.rank]) + suits[card.suit];
+}
+
+} // namespace sevens
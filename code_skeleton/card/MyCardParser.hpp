@@ -1,12 +1,15 @@
 #pragma once
 
 #include "Generic_card_parser.hpp"
+#include "DealFile.hpp"
+#include <memory>
 
 namespace sevens {
 
 /**
  * Derived class from Generic_card_parser.
- * Subclasses must fill in read_cards(...) to create a deck or read from file.
+ * read_cards("") creates the standard 52-card deck; read_cards(path) also
+ * opens a set of predefined deals (see DealFile) for fixed benchmark runs.
  */
 class MyCardParser : public Generic_card_parser {
 public:
@@ -14,6 +17,25 @@ public:
     ~MyCardParser() = default;
 
     void read_cards(const std::string& filename) override;
+
+    // Predefined deals loaded by read_cards(path), or nullptr for random deals
+    std::shared_ptr<const DealFile> get_deals() const {
+        return this->deals;
+    }
+
+    // Hands the card map over to the caller without copying it
+    std::unordered_map<uint64_t, Card> release_cards() {
+        return std::move(this->cards_hashmap);
+    }
+
+    // Short card notation used by rule and deal files: rank (A,2..10,T,J,Q,K)
+    // followed by suit (C,D,H,S), e.g. "7D", "10S", "AH". Card IDs are also accepted.
+    // Throws std::invalid_argument on malformed input.
+    static Card parse_card(const std::string& token);
+    static std::string card_to_string(const Card& card);
+
+private:
+    std::shared_ptr<const DealFile> deals;
 };
 
 } // namespace sevens
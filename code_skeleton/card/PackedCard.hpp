@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Generic_card_parser.hpp"
+#include <array>
+#include <cstdint>
+
+namespace sevens {
+
+/**
+ * One-byte card for hot loops: id = suit * 13 + rank - 1 (0..51), the same
+ * numbering as card IDs in cards_hashmap, DealFile records and the 52-bit
+ * masks of SuitIsomorphism.
+ *
+ * Everything derived from a card is read from a constexpr table built at
+ * compile time, so suit(), rank(), distance(), unlock() and priority() are
+ * single loads with no arithmetic or branches. unlock() and distance()
+ * follow the standard layout (7s open, rows grow outwards one rank at a
+ * time); rule variants go through MoveGenerator instead.
+ */
+struct PackedCard {
+    static constexpr uint8_t kCount = 52;
+    static constexpr uint8_t kNone = 0xFF;  // unlock() of a card that opens its row
+
+    uint8_t id = 0;
+
+    constexpr PackedCard() = default;
+    constexpr explicit PackedCard(uint8_t cardId) : id(cardId) {}
+    constexpr PackedCard(int suit, int rank) : id(static_cast<uint8_t>(suit * 13 + rank - 1)) {}
+    constexpr explicit PackedCard(const Card& card) : PackedCard(card.suit, card.rank) {}
+
+    constexpr int suit() const;
+    constexpr int rank() const;
+    constexpr Card card() const { return Card{suit(), rank()}; }
+    constexpr uint64_t bit() const { return 1ULL << id; }
+
+    // |rank - 7|
+    constexpr int distance() const;
+    // Id of the card that must be down before this one (kNone for a 7)
+    constexpr uint8_t unlock() const;
+    // GreedyStrategy's order: farther from 7 first, then higher suit. Unique per card.
+    constexpr uint8_t priority() const;
+
+    friend constexpr bool operator==(PackedCard a, PackedCard b) { return a.id == b.id; }
+    friend constexpr bool operator!=(PackedCard a, PackedCard b) { return a.id != b.id; }
+};
+
+namespace card_table {
+
+struct Entry {
+    uint8_t suit;
+    uint8_t rank;
+    uint8_t distance;
+    uint8_t unlock;
+    uint8_t priority;
+};
+
+constexpr std::array<Entry, PackedCard::kCount> build() {
+    std::array<Entry, PackedCard::kCount> entries{};
+    for (int id = 0; id < PackedCard::kCount; id++) {
+        const int suit = id / 13;
+        const int rank = id % 13 + 1;
+        const int distance = rank < 7 ? 7 - rank : rank - 7;
+        const int inner = rank < 7 ? rank + 1 : rank - 1;
+        entries[id] = Entry{static_cast<uint8_t>(suit), static_cast<uint8_t>(rank), static_cast<uint8_t>(distance),
+                            rank == 7 ? PackedCard::kNone : static_cast<uint8_t>(suit * 13 + inner - 1),
+                            static_cast<uint8_t>(distance * 4 + suit)};
+    }
+    return entries;
+}
+
+inline constexpr std::array<Entry, PackedCard::kCount> kEntries = build();
+
+} // namespace card_table
+
+constexpr int PackedCard::suit() const { return card_table::kEntries[id].suit; }
+constexpr int PackedCard::rank() const { return card_table::kEntries[id].rank; }
+constexpr int PackedCard::distance() const { return card_table::kEntries[id].distance; }
+constexpr uint8_t PackedCard::unlock() const { return card_table::kEntries[id].unlock; }
+constexpr uint8_t PackedCard::priority() const { return card_table::kEntries[id].priority; }
+
+static_assert(sizeof(PackedCard) == 1);
+static_assert(PackedCard(3, 13).id == 51 && PackedCard(3, 13).suit() == 3 && PackedCard(3, 13).rank() == 13);
+static_assert(PackedCard(0, 6).unlock() == PackedCard(0, 7).id && PackedCard(2, 8).unlock() == PackedCard(2, 7).id);
+static_assert(PackedCard(1, 7).unlock() == PackedCard::kNone && PackedCard(1, 1).distance() == 6);
+static_assert(PackedCard(3, 13).priority() > PackedCard(0, 1).priority() &&
+              PackedCard(0, 1).priority() > PackedCard(3, 12).priority());
+
+} // namespace sevens
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Generic_card_parser.hpp"
+#include "PackedCard.hpp"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Relabelling of the four suits: real suit s is canonical suit toCanonical[s],
+ * canonical suit c is real suit toReal[c].
+ */
+struct SuitPermutation {
+    std::array<uint8_t, 4> toCanonical{{0, 1, 2, 3}};
+    std::array<uint8_t, 4> toReal{{0, 1, 2, 3}};
+
+    Card canonical(const Card& card) const { return Card{toCanonical[card.suit], card.rank}; }
+    Card real(const Card& card) const { return Card{toReal[card.suit], card.rank}; }
+};
+
+/**
+ * A hand-plus-table state with its suits in canonical order.
+ *
+ * suits[c] packs canonical suit c as (hand ranks << 13) | table ranks, bit
+ * rank-1 in each 13-bit half. Two states related by a suit permutation
+ * canonicalize to the same `suits`, so it can key any per-state cache.
+ */
+struct CanonicalState {
+    std::array<uint32_t, 4> suits{};
+    SuitPermutation perm;
+
+    uint64_t hand() const { return unpack(13); }
+    uint64_t table() const { return unpack(0); }
+
+    // 64-bit mix of the 104 state bits (for hash tables and TT keys)
+    uint64_t hash() const {
+        uint64_t h = (static_cast<uint64_t>(suits[0]) << 26 | suits[1]) * 0x9E3779B97F4A7C15ULL;
+        h ^= (static_cast<uint64_t>(suits[2]) << 26 | suits[3]) + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+        return h ^ (h >> 31);
+    }
+
+    bool operator==(const CanonicalState& other) const { return suits == other.suits; }
+
+private:
+    uint64_t unpack(int shift) const {
+        uint64_t mask = 0;
+        for (int c = 0; c < 4; c++) mask |= static_cast<uint64_t>((suits[c] >> shift) & 0x1FFF) << (13 * c);
+        return mask;
+    }
+};
+
+/**
+ * Suit-isomorphism canonicalization. The four suits of Sevens are
+ * symmetric, so states that differ only by a relabelling of the suits have
+ * the same value; mapping them to one representative shrinks learned tables,
+ * transposition tables and opening books by up to 4! = 24x.
+ *
+ * Canonical order sorts the per-suit keys ascending (ties by real suit,
+ * which only happens between interchangeable suits) with a five-comparator
+ * sorting network. Masks use bit id = suit * 13 + rank - 1.
+ */
+class SuitIsomorphism {
+public:
+    // Permutation that sorts the four keys ascending
+    static SuitPermutation order(const std::array<uint32_t, 4>& keys) {
+        // Suit in the low bits makes every composite distinct, hence a stable order
+        std::array<uint64_t, 4> k;
+        for (int s = 0; s < 4; s++) k[s] = static_cast<uint64_t>(keys[s]) << 2 | s;
+        auto sort2 = [&k](int a, int b) {
+            if (k[b] < k[a]) std::swap(k[a], k[b]);
+        };
+        sort2(0, 1);
+        sort2(2, 3);
+        sort2(0, 2);
+        sort2(1, 3);
+        sort2(1, 2);
+
+        SuitPermutation perm;
+        for (int c = 0; c < 4; c++) {
+            perm.toReal[c] = static_cast<uint8_t>(k[c] & 3);
+            perm.toCanonical[k[c] & 3] = static_cast<uint8_t>(c);
+        }
+        return perm;
+    }
+
+    static CanonicalState canonicalize(uint64_t hand, uint64_t table) {
+        std::array<uint32_t, 4> keys;
+        for (int s = 0; s < 4; s++) {
+            keys[s] = static_cast<uint32_t>((hand >> (13 * s)) & 0x1FFF) << 13 |
+                      static_cast<uint32_t>((table >> (13 * s)) & 0x1FFF);
+        }
+        CanonicalState state;
+        state.perm = order(keys);
+        for (int c = 0; c < 4; c++) state.suits[c] = keys[state.perm.toReal[c]];
+        return state;
+    }
+
+    static CanonicalState canonicalize(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout)
+    {
+        return canonicalize(handMask(hand), tableMask(tableLayout));
+    }
+
+    // Apply a permutation to a 52-bit card mask (real -> canonical)
+    static uint64_t permuteMask(uint64_t mask, const SuitPermutation& perm) {
+        uint64_t out = 0;
+        for (int s = 0; s < 4; s++) {
+            out |= ((mask >> (13 * s)) & 0x1FFFULL) << (13 * perm.toCanonical[s]);
+        }
+        return out;
+    }
+
+    static uint64_t handMask(const std::vector<Card>& cards) {
+        uint64_t mask = 0;
+        for (const Card& card : cards) mask |= PackedCard(card).bit();
+        return mask;
+    }
+
+    static uint64_t tableMask(const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) {
+        uint64_t mask = 0;
+        for (const auto& suitPair : tableLayout) {
+            for (const auto& rankPair : suitPair.second) {
+                if (rankPair.second && suitPair.first < 4 && rankPair.first >= 1 && rankPair.first <= 13) {
+                    mask |= 1ULL << (suitPair.first * 13 + rankPair.first - 1);
+                }
+            }
+        }
+        return mask;
+    }
+};
+
+} // namespace sevens
@@ -0,0 +1,119 @@
+#include "card/DealFile.hpp"
+#include "card/MyCardParser.hpp"
+#include "game/mapper/MyGameMapper.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Creates and inspects fixed deal sets for benchmark runs.
+ *
+ *   ./deal_tool generate <out.deals> <count> <numPlayers> [seed] [rulesFile]
+ *       deal i is the deal MyGameMapper plays for seed + i
+ *   ./deal_tool convert  <in> <out.deals>       (text or binary -> binary)
+ *   ./deal_tool show     <file> [first] [count] (prints the text format)
+ */
+
+static void printUsage() {
+    std::cout << "Usage:\n"
+              << "  ./deal_tool generate <out.deals> <count> <numPlayers> [seed] [rulesFile]\n"
+              << "  ./deal_tool convert <in> <out.deals>\n"
+              << "  ./deal_tool show <file> [first] [count]\n";
+}
+
+static int generate(int argc, char* argv[]) {
+    if (argc < 5) {
+        printUsage();
+        return 1;
+    }
+    const std::string out = argv[2];
+    const uint64_t count = std::stoull(argv[3]);
+    const uint64_t numPlayers = std::stoull(argv[4]);
+    const uint64_t seed = (argc > 5) ? std::stoull(argv[5]) : 0;
+
+    // Deal exactly as a game seeded with seed + i would
+    MyGameMapper mapper;
+    mapper.read_cards("");
+    mapper.read_game(argc > 6 ? argv[6] : "");
+
+    std::unique_ptr<DealFileWriter> writer;
+    for (uint64_t i = 0; i < count; i++) {
+        Deal deal = mapper.previewDeal(numPlayers, seed + i);
+        if (!writer) {
+            size_t cards = 0;
+            for (const auto& hand : deal.hands) cards += hand.size();
+            writer = std::make_unique<DealFileWriter>(out, numPlayers, cards);
+        }
+        writer->write(deal);
+    }
+    if (writer) writer->close();
+
+    std::cout << "Wrote " << count << " deal(s) for " << numPlayers << " players to " << out << "\n";
+    return 0;
+}
+
+static int convert(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return 1;
+    }
+    DealFile in(argv[2]);
+    DealFileWriter writer(argv[3], in.numPlayers(), in.cardsPerDeal());
+    Deal deal;
+    for (uint64_t i = 0; i < in.size(); i++) {
+        in.get(i, deal);
+        writer.write(deal);
+    }
+    writer.close();
+    std::cout << "Converted " << in.size() << " deal(s) to " << argv[3] << "\n";
+    return 0;
+}
+
+static int show(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    DealFile in(argv[2]);
+    const uint64_t first = (argc > 3) ? std::stoull(argv[3]) : 0;
+    const uint64_t count = (argc > 4) ? std::stoull(argv[4]) : in.size();
+
+    std::cout << "# " << in.size() << " deal(s), " << in.numPlayers() << " players, "
+              << in.cardsPerDeal() << " cards each\n";
+    Deal deal;
+    for (uint64_t i = first; i < in.size() && i < first + count; i++) {
+        in.get(i, deal);
+        for (size_t seat = 0; seat < deal.hands.size(); seat++) {
+            if (seat > 0) std::cout << " |";
+            for (const Card& card : deal.hands[seat]) {
+                std::cout << " " << MyCardParser::card_to_string(card);
+            }
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    const std::string command = argv[1];
+    try {
+        if (command == "generate") return generate(argc, argv);
+        if (command == "convert") return convert(argc, argv);
+        if (command == "show") return show(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "[deal_tool] " << e.what() << std::endl;
+        return 1;
+    }
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,282 @@
+#include "DoubleDummy.hpp"
+#include "../../card/PackedCard.hpp"
+#include "../search/Zobrist.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace sevens {
+
+namespace {
+
+inline int bitOf(const Card& card) {
+    return PackedCard(card).id;
+}
+
+// Table slots are 16 bytes; tableBits is log2 of the slot count
+size_t tableMegabytes(unsigned tableBits) {
+    if (tableBits > 40) {
+        throw std::invalid_argument("Double-dummy table bits must be at most 40");
+    }
+    return std::max<size_t>(1, (size_t(1) << tableBits) * 16 >> 20);
+}
+
+// splitmix64 finaliser, to spread hand masks over the key space
+uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Entries keep the proven range lower <= position <= upper in their value
+int32_t packBounds(int lower, int upper) {
+    return lower | upper << 8;
+}
+
+} // namespace
+
+std::shared_ptr<TranspositionTable> DoubleDummyAnalyzer::makeTable(unsigned tableBits) {
+    return std::make_shared<TranspositionTable>(tableMegabytes(tableBits));
+}
+
+DoubleDummyAnalyzer::DoubleDummyAnalyzer(const GameRules& gameRules, unsigned tableBits,
+                                         uint64_t nodeBudget)
+    : DoubleDummyAnalyzer(gameRules, makeTable(tableBits), nodeBudget) {}
+
+DoubleDummyAnalyzer::DoubleDummyAnalyzer(const GameRules& gameRules, std::shared_ptr<TranspositionTable> sharedTable,
+                                         uint64_t nodeBudget)
+    : rules(gameRules),
+      table(std::move(sharedTable)),
+      node_budget(nodeBudget)
+{
+    if (!table) {
+        throw std::invalid_argument("Double-dummy analysis needs a transposition table");
+    }
+    if (rules.numDecks != 1) {
+        throw std::invalid_argument("Double-dummy analysis supports a single deck only");
+    }
+    // The search places every seat and breaks ties by seat order (stuckPosition)
+    if (!rules.playUntilAllFinish) {
+        throw std::invalid_argument("Double-dummy analysis needs rules played until every seat is placed");
+    }
+    if (rules.tieBreak != TieBreak::SeatOrder) {
+        throw std::invalid_argument("Double-dummy analysis supports seat-order tie breaks only");
+    }
+
+    // Same layout rules as the engine, flattened to 52-bit masks; the
+    // per-card unlockers only order the moves
+    layout = StateRules::compile(rules);
+    MoveGenerator gen = MoveGenerator::compile(rules);
+    for (int id = 0; id < 52; id++) {
+        const PackedCard card(static_cast<uint8_t>(id));
+        const int suit = card.suit();
+        const int rank = card.rank();
+        const uint8_t first = gen.unlockRank(rank, 0);
+        const uint8_t second = gen.unlockRank(rank, 1);
+        if (first != 0) unlockers[id] |= PackedCard(suit, first).bit();
+        if (second != 0) unlockers[id] |= PackedCard(suit, second).bit();
+    }
+    for (int id = 0; id < 52; id++) {
+        for (int other = 0; other < 52; other++) {
+            if (unlockers[other] >> id & 1ULL) unlocks[id] |= 1ULL << other;
+        }
+    }
+    for (const Card& card : rules.startCards) {
+        start_played |= 1ULL << bitOf(card);
+    }
+}
+
+uint64_t DoubleDummyAnalyzer::playableIn(uint64_t hand, uint64_t played) const {
+    return hand & layout.playable(played);
+}
+
+int DoubleDummyAnalyzer::nextSeat(int seat, uint64_t played) const {
+    for (int step = 1; step <= num_players; step++) {
+        int next = (seat + step) % num_players;
+        if (hands[next] & ~played) return next;
+    }
+    return seat;
+}
+
+int DoubleDummyAnalyzer::finishedOthers(uint64_t played) const {
+    int finished = 0;
+    for (int p = 0; p < num_players; p++) {
+        if (p != target && !(hands[p] & ~played)) finished++;
+    }
+    return finished;
+}
+
+int DoubleDummyAnalyzer::stuckPosition(uint64_t played) const {
+    // Nobody can move: rank the unplaced seats by cards left, then seat order
+    const int left = __builtin_popcountll(hands[target] & ~played);
+    int position = finishedOthers(played) + 1;
+    for (int p = 0; p < num_players; p++) {
+        if (p == target || !(hands[p] & ~played)) continue;
+        const int other = __builtin_popcountll(hands[p] & ~played);
+        if (other < left || (other == left && p < target)) position++;
+    }
+    return position;
+}
+
+bool DoubleDummyAnalyzer::prove(uint64_t played, uint64_t hash, int turn, int bound) {
+    const int best_possible = finishedOthers(played) + 1;
+    if (bound < best_possible) return false;
+    if (bound >= num_players) return true;
+
+    if (nodes_left == 0) {
+        aborted = true;
+        return false;
+    }
+    nodes_left--;
+    nodes++;
+    const Zobrist& zobrist = Zobrist::keys();
+    const uint64_t key = hash ^ zobrist.turnKey(turn) ^ solve_salt;
+    int lower = best_possible;
+    int upper = num_players;
+    TTEntry cached;
+    if (table->probe(key, cached)) {
+        const int cached_lower = cached.value & 0xFF;
+        const int cached_upper = cached.value >> 8;
+        if (cached_upper <= bound) return true;
+        if (cached_lower > bound) return false;
+        lower = cached_lower;
+        upper = cached_upper;
+    }
+
+    // OR node when the target (or, cooperatively, anyone) chooses, AND node otherwise
+    const bool chooser = cooperative || turn == target;
+
+    bool proven;
+    uint64_t moves = playableIn(hands[turn], played);
+    if (!moves) {
+        // Forced pass, unless nobody at the table can move any more
+        bool anyone = false;
+        for (int p = 0; p < num_players && !anyone; p++) {
+            anyone = playableIn(hands[p], played) != 0;
+        }
+        proven = anyone ? prove(played, hash, nextSeat(turn, played), bound)
+                        : stuckPosition(played) <= bound;
+    } else {
+        // Try first the moves that free the target's cards (when helping it)
+        // or that keep them locked (when opposing it)
+        const uint64_t wanted = hands[target] & ~played;
+        uint64_t first = 0;
+        for (uint64_t rest = moves; rest; rest &= rest - 1) {
+            const int id = __builtin_ctzll(rest);
+            if (((unlocks[id] & wanted) != 0) == chooser) first |= 1ULL << id;
+        }
+
+        proven = !chooser;
+        for (uint64_t batch : {first, moves & ~first}) {
+            while (batch && proven != chooser && !aborted) {
+                const int id = __builtin_ctzll(batch);
+                batch &= batch - 1;
+                const uint64_t next_played = played | (1ULL << id);
+
+                bool result;
+                if (!(hands[target] & ~next_played)) {
+                    result = true;   // The target just went out at best_possible <= bound
+                } else if (finishedOthers(next_played) == num_players - 1) {
+                    result = false;  // Everybody else is placed and bound < num_players
+                } else {
+                    result = prove(next_played, hash ^ zobrist.cardKey(PackedCard(static_cast<uint8_t>(id))),
+                                   nextSeat(turn, next_played), bound);
+                }
+
+                if (result == chooser) proven = result;
+            }
+        }
+    }
+
+    if (aborted) return false;  // Partial result, keep it out of the table
+    if (proven) {
+        upper = std::min(upper, bound);
+    } else {
+        lower = std::max(lower, bound + 1);
+    }
+    // Depth is the cards still to play, so bigger subtrees win replacement;
+    // the value carries both bounds, so only a closed range is marked Exact
+    TTEntry entry;
+    entry.value = packBounds(lower, upper);
+    entry.depth = static_cast<uint8_t>(52 - __builtin_popcountll(played));
+    entry.bound = lower == upper ? TTBound::Exact : TTBound::None;
+    table->store(key, entry);
+    return proven;
+}
+
+int DoubleDummyAnalyzer::solve(int seat, bool helped, uint64_t played, int lead, bool& exact) {
+    target = seat;
+    cooperative = helped;
+    nodes_left = node_budget;
+    aborted = false;
+    exact = true;
+    // Entries of other solves (here or on other threads) hold other targets
+    // or deals: the salt keeps them from matching, and the new generation
+    // lets them be evicted
+    solve_salt = mix(deal_key ^ (static_cast<uint64_t>(seat) * 2 + helped + 1) * 0x9E3779B97F4A7C15ULL);
+    table->newSearch();
+    const int best_possible = finishedOthers(played) + 1;
+    if (!(hands[target] & ~played)) {
+        return best_possible;
+    }
+    // Hash of the cards down, without a seat (prove() adds the seat to move)
+    const Zobrist& zobrist = Zobrist::keys();
+    const uint64_t hash = zobrist.position(played, 0) ^ zobrist.turnKey(0);
+
+    // Smallest position the seat can be proven to reach
+    for (int bound = best_possible; bound < num_players; bound++) {
+        if (prove(played, hash, lead, bound)) return bound;
+        if (aborted) {
+            exact = false;
+            return bound;
+        }
+    }
+    return num_players;
+}
+
+DoubleDummyResult DoubleDummyAnalyzer::analyze(const Deal& deal) {
+    num_players = static_cast<int>(deal.hands.size());
+    rules.validate(num_players);
+
+    hands.fill(0);
+    for (int p = 0; p < num_players; p++) {
+        for (const Card& card : deal.hands[p]) hands[p] |= 1ULL << bitOf(card);
+    }
+    deal_key = 0;
+    for (int p = 0; p < num_players; p++) {
+        deal_key ^= mix(hands[p] ^ Zobrist::keys().turnKey(p));
+    }
+
+    // The holder of the opening card (if any) plays it before anyone else
+    uint64_t played = start_played;
+    int lead = 0;
+    if (rules.hasFirstCard) {
+        const uint64_t first = 1ULL << bitOf(rules.firstCard);
+        for (int p = 0; p < num_players; p++) {
+            if (hands[p] & first) {
+                played |= first;
+                lead = nextSeat(p, played);
+                break;
+            }
+        }
+    }
+
+    DoubleDummyResult result;
+    nodes = 0;
+    for (int seat = 0; seat < num_players; seat++) {
+        bool best_exact;
+        bool guaranteed_exact;
+        result.bestPosition.push_back(static_cast<uint8_t>(solve(seat, true, played, lead, best_exact)));
+        result.guaranteedPosition.push_back(
+            static_cast<uint8_t>(solve(seat, false, played, lead, guaranteed_exact)));
+        result.exact.push_back(best_exact && guaranteed_exact);
+        result.strength.push_back(static_cast<double>(num_players - result.guaranteedPosition.back()) /
+                                  (num_players - 1));
+    }
+    auto bounds = std::minmax_element(result.strength.begin(), result.strength.end());
+    result.luck = *bounds.second - *bounds.first;
+    result.nodes = nodes;
+    return result;
+}
+
+} // namespace sevens
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../../card/DealFile.hpp"
+#include "../rules/GameRules.hpp"
+#include "../rules/GameState.hpp"
+#include "../rules/MoveGenerator.hpp"
+#include "../search/TranspositionTable.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Per-deal output of the double-dummy analyzer (positions are 1-based).
+ *   bestPosition:       finish reachable if every player helps the seat
+ *   guaranteedPosition: finish the seat can force against adversarial opponents
+ *   strength:           (N - guaranteed) / (N - 1), 1 = the deal wins by force
+ *   luck:               max - min strength over the seats (how lopsided the deal is)
+ *   exact:              0 if the node budget ran out; the position is then the
+ *                       best one not yet ruled out (a lower bound)
+ */
+struct DoubleDummyResult {
+    std::vector<uint8_t> bestPosition;
+    std::vector<uint8_t> guaranteedPosition;
+    std::vector<double> strength;
+    std::vector<uint8_t> exact;
+    double luck = 0.0;
+    uint64_t nodes = 0;
+};
+
+/**
+ * Perfect-information ("double dummy") search over a Sevens deal.
+ *
+ * With every hand visible the state is just the set of played cards and the
+ * seat to move, so positions are memoised in a TranspositionTable under their
+ * Zobrist hash, salted with a key of the solve (the hands, seat and mode). Each
+ * position is solved as a series of AND/OR proofs ("can the seat finish at
+ * position <= k?") for increasing k; the table keeps the proven lower/upper
+ * bounds so later proofs reuse earlier ones.
+ *
+ * Supports single-deck rulesets (any opening rank, ace mode, starting layout
+ * and opening card) played until every seat is placed, with seat-order
+ * ties; the constructor throws std::invalid_argument for other rules. A few
+ * deals have very large adversarial trees, so each solve has a node budget.
+ *
+ * One analyzer per thread. Each either owns a table of 2^tableBits slots or
+ * shares one (see makeTable) with analyzers of the same rules on other
+ * threads; the salt keeps their solves apart, and the table is reused across
+ * deals without clearing.
+ */
+class DoubleDummyAnalyzer {
+public:
+    explicit DoubleDummyAnalyzer(const GameRules& rules, unsigned tableBits = 22,
+                                 uint64_t nodeBudget = 20000000);
+    DoubleDummyAnalyzer(const GameRules& rules, std::shared_ptr<TranspositionTable> table,
+                        uint64_t nodeBudget = 20000000);
+
+    // A table of 2^tableBits 16-byte slots, for analyzers to share
+    static std::shared_ptr<TranspositionTable> makeTable(unsigned tableBits);
+
+    DoubleDummyResult analyze(const Deal& deal);
+
+private:
+    GameRules rules;
+    uint64_t start_played = 0;
+    StateRules layout;                      // Move rules shared with the engine
+    std::array<uint64_t, 52> unlockers{};   // Cards that make each card playable
+    std::array<uint64_t, 52> unlocks{};      // Cards each card makes playable
+
+    int num_players = 0;
+    int target = 0;
+    bool cooperative = false;
+    std::array<uint64_t, GameRules::kMaxPlayers> hands{};
+
+    std::shared_ptr<TranspositionTable> table;
+    uint64_t deal_key = 0;                 // Hash of the hands being analyzed
+    uint64_t solve_salt = 0;               // XORed into every key of the current solve
+    uint64_t nodes = 0;
+    uint64_t node_budget;
+    uint64_t nodes_left = 0;               // Per solve; 0 aborts the search
+    bool aborted = false;
+
+    uint64_t playableIn(uint64_t hand, uint64_t played) const;
+    int nextSeat(int seat, uint64_t played) const;
+    int finishedOthers(uint64_t played) const;
+    int stuckPosition(uint64_t played) const;
+    // `hash` is the Zobrist hash of `played`, kept up to date incrementally
+    bool prove(uint64_t played, uint64_t hash, int turn, int bound);
+    int solve(int seat, bool helped, uint64_t played, int lead, bool& exact);
+};
+
+} // namespace sevens
@@ -0,0 +1,97 @@
+#include "GameProfile.hpp"
+
+#include <chrono>
+
+namespace sevens {
+
+namespace {
+
+void count(std::vector<uint64_t>& histogram, uint64_t value, uint64_t times = 1) {
+    if (histogram.size() <= value) histogram.resize(value + 1, 0);
+    histogram[value] += times;
+}
+
+void add(std::vector<uint64_t>& into, const std::vector<uint64_t>& from) {
+    if (into.size() < from.size()) into.resize(from.size(), 0);
+    for (size_t i = 0; i < from.size(); i++) into[i] += from[i];
+}
+
+} // namespace
+
+void GameProfile::merge(const GameProfile& other) {
+    games += other.games;
+    add(legalMoves, other.legalMoves);
+    add(gameLengths, other.gameLengths);
+    add(roundCounts, other.roundCounts);
+    if (seats.size() < other.seats.size()) seats.resize(other.seats.size());
+    for (size_t i = 0; i < other.seats.size(); i++) {
+        seats[i].turns += other.seats[i].turns;
+        seats[i].passes += other.seats[i].passes;
+        seats[i].forced += other.seats[i].forced;
+    }
+    for (const auto& [name, counts] : other.strategies) {
+        Strategy& mine = strategies[name];
+        mine.calls += counts.calls;
+        mine.callNanos += counts.callNanos;
+        mine.forcedCalls += counts.forcedCalls;
+        mine.forcedNanos += counts.forcedNanos;
+        mine.forcedDiffered += counts.forcedDiffered;
+    }
+}
+
+GameProfiler::GameProfiler(const MyGameMapper& prototype, std::vector<std::shared_ptr<PlayerStrategy>> seats,
+                           std::vector<std::string> names)
+    : mapper(prototype), seats(std::move(seats)), names(std::move(names))
+{
+    mapper.setForcedMoveShortcut(false);
+    for (uint64_t seat = 0; seat < this->seats.size(); seat++) {
+        mapper.registerStrategy(seat, this->seats[seat]);
+    }
+}
+
+void GameProfiler::play(uint64_t seed, GameProfile& profile) {
+    const uint64_t numPlayers = seats.size();
+    if (profile.seats.size() < numPlayers) profile.seats.resize(numPlayers);
+
+    // Look the per-seat counters up once per game rather than per turn
+    std::vector<GameProfile::Strategy*> counters(numPlayers);
+    for (uint64_t seat = 0; seat < numPlayers; seat++) counters[seat] = &profile.strategies[names[seat]];
+
+    mapper.setDealSeed(seed);
+    mapper.beginGame(numPlayers);
+    uint64_t seat;
+    while (mapper.nextDecision(seat)) {
+        const std::vector<Card>& moves = mapper.pendingMoves();
+        const auto start = std::chrono::steady_clock::now();
+        const int choice = seats[seat]->selectCardToPlay(moves, mapper.getTableLayout());
+        const uint64_t nanos = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+        GameProfile::Strategy& strategy = *counters[seat];
+        strategy.calls++;
+        strategy.callNanos += nanos;
+        if (moves.size() == 1) {
+            profile.seats[seat].forced++;
+            strategy.forcedCalls++;
+            strategy.forcedNanos += nanos;
+            if (choice != 0) strategy.forcedDiffered++;
+        }
+        profile.seats[seat].turns++;
+        count(profile.legalMoves, moves.size());
+        mapper.applyDecision(choice);
+    }
+    mapper.endGame();
+
+    // Passes never reach the loop above
+    const GameStats& stats = mapper.getLastGameStats();
+    for (uint64_t s = 0; s < numPlayers; s++) {
+        profile.seats[s].turns += stats.passes[s];
+        profile.seats[s].passes += stats.passes[s];
+        count(profile.legalMoves, 0, stats.passes[s]);
+    }
+    count(profile.gameLengths, stats.turns);
+    count(profile.roundCounts, stats.rounds);
+    profile.games++;
+}
+
+} // namespace sevens
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../mapper/MyGameMapper.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Shape of the games actually played: how many legal moves each turn
+ * offered, how often a seat was forced or had to pass, and what the
+ * strategies did with positions that had only one answer.
+ *
+ * Histograms are indexed by value (legalMoves[3] = turns with exactly
+ * three legal moves; legalMoves[0] counts passes). Profiles from several
+ * threads are combined with merge().
+ */
+struct GameProfile {
+    struct Seat {
+        uint64_t turns = 0;   // Turns the seat was still holding cards
+        uint64_t passes = 0;
+        uint64_t forced = 0;  // Turns with exactly one legal move
+    };
+
+    struct Strategy {
+        uint64_t calls = 0;
+        uint64_t callNanos = 0;
+        uint64_t forcedCalls = 0;     // Calls the forced-move shortcut would skip
+        uint64_t forcedNanos = 0;
+        uint64_t forcedDiffered = 0;  // Forced calls not answered with index 0
+    };
+
+    uint64_t games = 0;
+    std::vector<uint64_t> legalMoves;
+    std::vector<uint64_t> gameLengths;  // Cards played per game
+    std::vector<uint64_t> roundCounts;
+    std::vector<Seat> seats;
+    std::map<std::string, Strategy> strategies;
+
+    void merge(const GameProfile& other);
+};
+
+/**
+ * Plays games through MyGameMapper's stepwise interface with the
+ * forced-move shortcut off, so every turn reaches the strategy, and
+ * records each turn in a GameProfile. The strategies also get their usual
+ * lifecycle and observation calls. One profiler per thread.
+ */
+class GameProfiler {
+public:
+    // names[i] labels seat i's strategy in the profile
+    GameProfiler(const MyGameMapper& prototype, std::vector<std::shared_ptr<PlayerStrategy>> seats,
+                 std::vector<std::string> names);
+
+    // Play one game with the given deal seed
+    void play(uint64_t seed, GameProfile& profile);
+
+private:
+    MyGameMapper mapper;
+    std::vector<std::shared_ptr<PlayerStrategy>> seats;
+    std::vector<std::string> names;
+};
+
+} // namespace sevens
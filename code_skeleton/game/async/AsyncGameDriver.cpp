@@ -0,0 +1,195 @@
+#include "AsyncGameDriver.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace sevens {
+
+namespace {
+
+// Registered in a game's mapper for a seat whose source wants events
+class SourceRelay : public PlayerStrategy {
+public:
+    SourceRelay(DecisionSource& source, uint64_t gameId, uint64_t seat)
+        : source(source), game_id(gameId), seat(seat) {}
+
+    void initialize(uint64_t) override {}
+    void onGameStart(const GameStartInfo& info) override { source.onGameStart(game_id, info); }
+    void onGameEnd(uint64_t finalRank) override { source.onGameEnd(game_id, seat, finalRank); }
+    int selectCardToPlay(const std::vector<Card>&,
+                         const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>&) override {
+        return -1;  // Stepwise games never ask
+    }
+    void observeMove(uint64_t playerID, const Card& playedCard) override {
+        source.onMove(game_id, seat, playerID, playedCard);
+    }
+    void observePass(uint64_t playerID) override { source.onPass(game_id, seat, playerID); }
+    std::string getName() const override { return "SourceRelay"; }
+
+private:
+    DecisionSource& source;
+    uint64_t game_id;
+    uint64_t seat;
+};
+
+} // namespace
+
+void DecisionRequest::complete(int moveIndex) {
+    // Read everything first: once posted, the game may reuse this request
+    GameScheduler* target = scheduler;
+    std::coroutine_handle<> waiting = handle;
+    answer = moveIndex;
+    if (state.exchange(1) == 2) {
+        target->post(waiting);
+    }
+}
+
+bool DecisionAwaitable::await_suspend(std::coroutine_handle<> handle) {
+    request.scheduler = &scheduler;
+    request.handle = handle;
+    request.answer = -1;
+    request.state.store(0, std::memory_order_relaxed);
+    source.request(request);
+
+    // Answered before we got here (inline source, or a very fast one): keep running
+    int expected = 0;
+    return request.state.compare_exchange_strong(expected, 2);
+}
+
+void BatchStrategySource::flush() {
+    if (pending.empty()) return;
+    // Completing only queues the games, so pending cannot grow under us; swap anyway
+    in_batch.swap(pending);
+    positions.clear();
+    for (DecisionRequest* request : in_batch) {
+        positions.push_back(BatchDecision{request->seat, request->validMoves, request->hand, request->tableLayout});
+    }
+    strategy->selectCardsBatch(positions, choices);
+    batch_count++;
+    decision_count += in_batch.size();
+    for (size_t i = 0; i < in_batch.size(); i++) {
+        in_batch[i]->complete(choices[i]);
+    }
+    in_batch.clear();
+}
+
+GameScheduler::GameScheduler(const MyGameMapper& prototype) : prototype(prototype) {
+}
+
+void GameScheduler::setSeats(std::vector<DecisionSource*> newSeats) {
+    seats = std::move(newSeats);
+    sources.clear();
+    for (DecisionSource* source : seats) {
+        if (std::find(sources.begin(), sources.end(), source) == sources.end()) sources.push_back(source);
+    }
+}
+
+void GameScheduler::post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex);
+        ready.push_back(handle);
+    }
+    ready_cv.notify_one();
+}
+
+GameTask GameScheduler::playGame(uint64_t gameId, uint64_t numPlayers, uint64_t seed) {
+    // Each game owns a copy of the prototype for its whole lifetime
+    MyGameMapper mapper = prototype;
+    for (uint64_t seat = 0; seat < numPlayers; seat++) {
+        if (seats[seat]->wantsEvents()) {
+            mapper.registerStrategy(seat, std::make_shared<SourceRelay>(*seats[seat], gameId, seat));
+        }
+    }
+    if (replay_deals) {
+        mapper.useDeal(seed);
+    } else {
+        mapper.setDealSeed(seed);
+    }
+    mapper.beginGame(numPlayers);
+
+    DecisionRequest request;
+    request.gameId = gameId;
+    request.validMoves = &mapper.pendingMoves();
+    request.tableLayout = &mapper.getTableLayout();
+
+    uint64_t seat;
+    while (mapper.nextDecision(seat)) {
+        request.seat = seat;
+        request.hand = &mapper.getHand(seat);
+        const int moveIndex = co_await DecisionAwaitable(*seats[seat], request, *this);
+        mapper.applyDecision(moveIndex);
+    }
+
+    AsyncGameResult result;
+    result.gameId = gameId;
+    result.dealSeed = seed;
+    result.rankings = mapper.endGame();
+    result.chipBalances = mapper.getChipBalances();
+    result.stats = mapper.getLastGameStats();
+    co_return result;
+}
+
+void GameScheduler::run(uint64_t numPlayers, uint64_t games, uint64_t firstSeed, size_t maxInFlight,
+                        const std::function<void(const AsyncGameResult&)>& onResult) {
+    if (seats.size() < numPlayers) {
+        throw std::invalid_argument("GameScheduler needs a decision source for every seat");
+    }
+    if (maxInFlight == 0) {
+        throw std::invalid_argument("GameScheduler needs at least one game in flight");
+    }
+
+    std::unordered_map<void*, GameTask> live;
+    std::exception_ptr error;
+    uint64_t started = 0;
+
+    // Retire a game once its coroutine has run to completion
+    auto settle = [&](std::coroutine_handle<> handle) {
+        if (!handle.done()) return;
+        auto it = live.find(handle.address());
+        auto& promise = it->second.handle.promise();
+        if (promise.error) {
+            if (!error) error = promise.error;
+        } else if (!error) {
+            onResult(promise.result);
+        }
+        live.erase(it);
+    };
+
+    std::deque<std::coroutine_handle<>> batch;
+    while (!live.empty() || (started < games && !error)) {
+        // Top up the games in flight; each runs until its first wait
+        while (live.size() < maxInFlight && started < games && !error) {
+            GameTask task = playGame(game_id_base + started, numPlayers, firstSeed + started);
+            std::coroutine_handle<> handle = task.handle;
+            live.emplace(handle.address(), std::move(task));
+            started++;
+            handle.resume();
+            settle(handle);
+        }
+        if (live.empty()) continue;
+
+        // Everything runnable has run: let batching sources answer the wave
+        for (DecisionSource* source : sources) {
+            source->flush();
+        }
+
+        // Take every answered game at once, then resume them without the lock
+        {
+            std::unique_lock<std::mutex> lock(ready_mutex);
+            ready_cv.wait(lock, [this]() { return !ready.empty(); });
+            batch.swap(ready);
+        }
+        while (!batch.empty()) {
+            std::coroutine_handle<> handle = batch.front();
+            batch.pop_front();
+            handle.resume();
+            settle(handle);
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace sevens
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "../mapper/MyGameMapper.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace sevens {
+
+class GameScheduler;
+
+/**
+ * One move decision a game is waiting for. The pointers stay valid until
+ * complete() is called; the game does not run in the meantime.
+ */
+class DecisionRequest {
+public:
+    uint64_t gameId = 0;
+    uint64_t seat = 0;
+    const std::vector<Card>* validMoves = nullptr;
+    const std::vector<Card>* hand = nullptr;  // Every card the seat holds
+    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>* tableLayout = nullptr;
+
+    // Deliver the answer (index into validMoves). Call exactly once, from any thread.
+    void complete(int moveIndex);
+
+private:
+    friend class DecisionAwaitable;
+
+    GameScheduler* scheduler = nullptr;
+    std::coroutine_handle<> handle;
+    int answer = -1;
+    // 0 waiting, 1 answered, 2 game suspended (the answer must reschedule it)
+    std::atomic<int> state{0};
+};
+
+/**
+ * Where a seat's decisions come from: a remote bot, a batched model server,
+ * an in-process strategy... request() must not block; it hands the request
+ * off and the answer arrives later through request.complete().
+ */
+class DecisionSource {
+public:
+    virtual ~DecisionSource() = default;
+    virtual void request(DecisionRequest& request) = 0;
+
+    // Called by the scheduler whenever every runnable game has reached its
+    // next decision; sources that batch requests answer them here.
+    virtual void flush() {}
+
+    // Sources that keep per-game state elsewhere (a remote bot) return true
+    // to also get each game's lifecycle and observation events for the seats
+    // they play. These run on the scheduler thread and must not block.
+    virtual bool wantsEvents() const { return false; }
+    virtual void onGameStart(uint64_t gameId, const GameStartInfo& info) { (void)gameId; (void)info; }
+    virtual void onMove(uint64_t gameId, uint64_t seat, uint64_t playerID, const Card& card) {
+        (void)gameId; (void)seat; (void)playerID; (void)card;
+    }
+    virtual void onPass(uint64_t gameId, uint64_t seat, uint64_t playerID) {
+        (void)gameId; (void)seat; (void)playerID;
+    }
+    virtual void onGameEnd(uint64_t gameId, uint64_t seat, uint64_t finalRank) {
+        (void)gameId; (void)seat; (void)finalRank;
+    }
+};
+
+/**
+ * Answers inline from a PlayerStrategy. Observations and lifecycle calls are
+ * not forwarded, and the strategy is shared by every game in flight, so this
+ * suits stateless strategies (random, greedy) only.
+ */
+class StrategySource : public DecisionSource {
+public:
+    explicit StrategySource(std::shared_ptr<PlayerStrategy> strategy) : strategy(std::move(strategy)) {}
+
+    void request(DecisionRequest& request) override {
+        request.complete(strategy->selectCardToPlay(*request.validMoves, *request.tableLayout));
+    }
+
+private:
+    std::shared_ptr<PlayerStrategy> strategy;
+};
+
+/**
+ * Collects requests and answers each wave of them with one
+ * selectCardsBatch() call on a strategy shared by all games in flight.
+ */
+class BatchStrategySource : public DecisionSource {
+public:
+    explicit BatchStrategySource(std::shared_ptr<PlayerStrategy> strategy) : strategy(std::move(strategy)) {}
+
+    void request(DecisionRequest& request) override { pending.push_back(&request); }
+    void flush() override;
+
+    uint64_t batches() const { return batch_count; }
+    uint64_t decisions() const { return decision_count; }
+
+private:
+    std::shared_ptr<PlayerStrategy> strategy;
+    std::vector<DecisionRequest*> pending;
+    std::vector<DecisionRequest*> in_batch;
+    std::vector<BatchDecision> positions;
+    std::vector<int> choices;
+    uint64_t batch_count = 0;
+    uint64_t decision_count = 0;
+};
+
+// co_await target: suspends the game until its DecisionSource answers
+class DecisionAwaitable {
+public:
+    DecisionAwaitable(DecisionSource& source, DecisionRequest& request, GameScheduler& scheduler)
+        : source(source), request(request), scheduler(scheduler) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle);
+    int await_resume() const noexcept { return request.answer; }
+
+private:
+    DecisionSource& source;
+    DecisionRequest& request;
+    GameScheduler& scheduler;
+};
+
+struct AsyncGameResult {
+    uint64_t gameId = 0;
+    uint64_t dealSeed = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> rankings;
+    std::vector<int64_t> chipBalances;
+    GameStats stats;  // decisionNanos stays zero: decisions are made outside the engine
+};
+
+// Coroutine type of one game; started and resumed only by GameScheduler
+class GameTask {
+public:
+    struct promise_type {
+        AsyncGameResult result;
+        std::exception_ptr error;
+
+        GameTask get_return_object() {
+            return GameTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(AsyncGameResult value) { result = std::move(value); }
+        void unhandled_exception() { error = std::current_exception(); }
+
+        // The frame holds the game's MyGameMapper, whose GameState is
+        // cache-line aligned, but frames come from the plain operator new
+        static void* operator new(std::size_t size) {
+            return ::operator new(size, std::align_val_t(alignof(MyGameMapper)));
+        }
+        static void operator delete(void* frame, std::size_t size) {
+            ::operator delete(frame, size, std::align_val_t(alignof(MyGameMapper)));
+        }
+    };
+
+    explicit GameTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    GameTask(GameTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    GameTask(const GameTask&) = delete;
+    GameTask& operator=(const GameTask&) = delete;
+    ~GameTask() {
+        if (handle) handle.destroy();
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * Single-threaded driver that multiplexes many games on the calling thread.
+ *
+ * Every game is a coroutine running MyGameMapper's stepwise API on its own
+ * copy of the prototype mapper; each decision is a co_await on the seat's
+ * DecisionSource. While a game waits, the scheduler resumes whichever games
+ * have their answers, so one thread keeps thousands of games in flight
+ * behind slow or batched decision backends. Sources may answer from any
+ * thread; answers are queued and the games resume on the scheduler thread.
+ * Once every runnable game is waiting again, each source is flushed, so
+ * batching sources see one wave of decisions from all games per call.
+ *
+ * The prototype should have its cards and rules loaded and no strategies
+ * registered (seats are played by the sources).
+ */
+class GameScheduler {
+public:
+    explicit GameScheduler(const MyGameMapper& prototype);
+
+    // One source per seat; they must outlive run()
+    void setSeats(std::vector<DecisionSource*> seats);
+
+    // Replay the prototype's predefined deals (read_cards(path)) instead of
+    // seeding: game i then plays deal firstSeed + i
+    void setReplayDeals(bool replay) { replay_deals = replay; }
+
+    // Game ids are base, base + 1, ... (default 0); schedulers that share a
+    // source on different threads need disjoint ranges
+    void setGameIdBase(uint64_t base) { game_id_base = base; }
+
+    // Play `games` games with deal seeds firstSeed, firstSeed + 1, ..., keeping
+    // at most maxInFlight games started at once. onResult runs on this thread
+    // as games finish (in completion order). Rethrows the first game error.
+    void run(uint64_t numPlayers, uint64_t games, uint64_t firstSeed, size_t maxInFlight,
+             const std::function<void(const AsyncGameResult&)>& onResult);
+
+    // Make a suspended game runnable again (thread-safe; used by DecisionRequest)
+    void post(std::coroutine_handle<> handle);
+
+private:
+    MyGameMapper prototype;
+    std::vector<DecisionSource*> seats;
+    std::vector<DecisionSource*> sources;  // Distinct entries of seats
+    bool replay_deals = false;
+    uint64_t game_id_base = 0;
+
+    std::mutex ready_mutex;
+    std::condition_variable ready_cv;
+    std::deque<std::coroutine_handle<>> ready;
+
+    GameTask playGame(uint64_t gameId, uint64_t numPlayers, uint64_t seed);
+};
+
+} // namespace sevens
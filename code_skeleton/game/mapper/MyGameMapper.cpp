@@ -26,7 +26,15 @@ void MyGameMapper::read_cards(const std::string& filename) {
     // Don't call the base class (it's pure virtual)
     MyCardParser cardParser;
     cardParser.read_cards(filename);
-    cards_hashmap = cardParser.get_cards_hashmap();
+    cards_hashmap = cardParser.release_cards();
+    deal_file = cardParser.get_deals();
+    
+    // Sorted once here so dealing never walks the hash map
+    std::vector<std::pair<uint64_t, Card>> ordered(cards_hashmap.begin(), cards_hashmap.end());
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    card_order.clear();
+    for (const auto& pair : ordered) card_order.push_back(PackedCard(pair.second));
 }
 
 void MyGameMapper::read_game(const std::string& filename) {
@@ -34,6 +42,7 @@ void MyGameMapper::read_game(const std::string& filename) {
     MyGameParser gameParser;
     gameParser.read_game(filename);
     table_cards = gameParser.get_table_layout();
+    setRules(gameParser.get_rules());
 }
 
 
@@ -62,33 +71,79 @@ bool MyGameMapper::hasRegisteredStrategies() const {
 
 void MyGameMapper::registerStrategy(uint64_t playerID, std::shared_ptr<PlayerStrategy> strategy) {
     player_strategies[playerID] = strategy;
-    std::cout << "[MyGameMapper::registerStrategy] Stored strategy for player " << playerID << ".\n";
 }
 
-std::vector<std::pair<uint64_t, uint64_t>> MyGameMapper::compute_game_progress(uint64_t numPlayers) {
-    // Setup game state
-    setupGame(numPlayers);
-    
-    // Play rounds until someone wins
-    while (!isGameOver()) {
-        playRound(false); // Play quietly
+void MyGameMapper::setDealSeed(uint64_t seed) {
+    deal_seed = seed;
+    deal_seed_pinned = true;
+}
+
+uint64_t MyGameMapper::getLastDealSeed() const {
+    return deal_seed;
+}
+
+uint64_t MyGameMapper::getDealCount() const {
+    return deal_file ? deal_file->size() : 0;
+}
+
+void MyGameMapper::useDeal(uint64_t index) {
+    if (!deal_file || index >= deal_file->size()) {
+        throw std::out_of_range("No predefined deal " + std::to_string(index));
     }
-    
-    // Return results as (playerID, rank) pairs
-    return getFinalRankings();
+    deal_seed = index;
+    deal_seed_pinned = true;
+    deal_from_file = true;
+}
+
+void MyGameMapper::setRules(const GameRules& newRules) {
+    newRules.validate(GameRules::kMinPlayers);
+    rules = newRules;
+    move_gen = MoveGenerator::compile(rules);
+    state_rules = StateRules::compile(rules);
+}
+
+const GameRules& MyGameMapper::getRules() const {
+    return rules;
+}
+
+const std::vector<int64_t>& MyGameMapper::getChipBalances() const {
+    return chip_balances;
+}
+
+void MyGameMapper::setIllegalMovePolicy(IllegalMovePolicy policy) {
+    illegal_policy = policy;
+}
+
+IllegalMovePolicy MyGameMapper::getIllegalMovePolicy() const {
+    return illegal_policy;
+}
+
+const std::vector<uint64_t>& MyGameMapper::getIllegalMoveCounts() const {
+    return illegal_moves;
+}
+
+const GameStats& MyGameMapper::getLastGameStats() const {
+    return stats;
+}
+
+void MyGameMapper::setDecisionTiming(bool enabled) {
+    time_decisions = enabled;
+}
+
+void MyGameMapper::setForcedMoveShortcut(bool enabled) {
+    forced_shortcut = enabled;
+}
+
+bool MyGameMapper::getForcedMoveShortcut() const {
+    return forced_shortcut;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> MyGameMapper::compute_game_progress(uint64_t numPlayers) {
+    return runGame(numPlayers, false); // Play quietly
 }
 
 std::vector<std::pair<uint64_t, uint64_t>> MyGameMapper::compute_and_display_game(uint64_t numPlayers) {
-    // Setup game state
-    setupGame(numPlayers);
-    
-    // Play rounds until someone wins
-    while (!isGameOver()) {
-        playRound(true); // Play with output
-    }
-    
-    // Return results as (playerID, rank) pairs
-    return getFinalRankings();
+    return runGame(numPlayers, true); // Play with output
 }
 
 std::vector<std::pair<std::string, uint64_t>> 
@@ -117,39 +172,225 @@ MyGameMapper::compute_and_display_game(const std::vector<std::string>& playerNam
     return namedResults;
 }
 
+Deal MyGameMapper::previewDeal(uint64_t numPlayers, uint64_t seed) const {
+    rules.validate(numPlayers);
+    std::vector<PackedCard> cards;
+    Deal deal;
+    deal.hands.assign(numPlayers, std::vector<Card>());
+    dealCards(seed, cards, deal.hands);
+    return deal;
+}
+
 // Private helper methods
+std::vector<std::pair<uint64_t, uint64_t>> MyGameMapper::runGame(uint64_t numPlayers, bool verbose) {
+    // Setup game state
+    beginGame(numPlayers, verbose);
+    
+    // Play turns until the game is over
+    uint64_t player_id;
+    while (nextDecision(player_id)) {
+        const std::vector<Card>& valid_moves = valid_moves_buffer;
+        
+        // Choose move based on strategy
+        int move_index;
+        auto strategy = player_strategies.find(player_id);
+        if (strategy != player_strategies.end()) {
+            if (time_decisions) {
+                const auto start = std::chrono::steady_clock::now();
+                move_index = strategy->second->selectCardToPlay(valid_moves, table_cards);
+                stats.decisionNanos[player_id] += static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                        .count());
+            } else {
+                move_index = strategy->second->selectCardToPlay(valid_moves, table_cards);
+            }
+        } else {
+            // Default strategy: random
+            std::uniform_int_distribution<size_t> dist(0, valid_moves.size() - 1);
+            move_index = static_cast<int>(dist(rng));
+        }
+        
+        // Make the move (illegal indices are handled by the policy)
+        playChosen(player_id, resolveMove(player_id, move_index));
+    }
+    
+    // Return results as (playerID, rank) pairs
+    return endGame();
+}
+
 void MyGameMapper::setupGame(uint64_t numPlayers) {
+    rules.validate(numPlayers);
+    
     // Initialize player hands, table state, etc.
     // For each player, create empty hand
-    player_hands.clear();
     player_hands.resize(numPlayers);
+    for (auto& hand : player_hands) hand.clear();  // Keeps each hand's storage
+    chip_balances.assign(numPlayers, 0);
+    illegal_moves.assign(numPlayers, 0);
+    pot = 0;
     
-    // Deal cards to players
-    dealCards();
+    // Pick the seed of this deal unless the caller pinned one
+    if (!deal_seed_pinned) {
+        std::uniform_int_distribution<uint64_t> seedDist;
+        deal_seed = seedDist(rng);
+    }
+    deal_seed_pinned = false;
+    
+    stats.dealSeed = deal_seed;
+    stats.turns = 0;
+    stats.rounds = 0;
+    stats.passes.assign(numPlayers, 0);
+    stats.decisions.assign(numPlayers, 0);
+    stats.forced.assign(numPlayers, 0);
+    stats.cardsLeft.assign(numPlayers, 0);
+    stats.decisionNanos.assign(numPlayers, 0);
     
-    // Initialize table state
+    // Initialize table state first so the starting cards stay out of the deck
     initializeTable();
+    
+    // Deal cards to players
+    if (deal_from_file) {
+        deal_from_file = false;
+        dealFromFile();
+    } else {
+        dealCards(deal_seed, deck, player_hands);
+    }
+    
+    // Turn order starts with the holder of the opening card, if the rules have one
+    state.deal(state_rules, player_hands);
+}
+
+void MyGameMapper::notifyGameStart() {
+    // Refilled in place: the vectors keep their capacity from game to game
+    GameStartInfo& info = start_info;
+    info.numPlayers = player_hands.size();
+    info.numDecks = rules.numDecks;
+    info.dealSeed = deal_seed;
+    info.handSizes.clear();
+    for (const auto& hand : player_hands) {
+        info.handSizes.push_back(hand.size());
+    }
+    info.tableCards.clear();
+    for (int suit = 0; suit < 4; suit++) {
+        for (int rank = 1; rank <= 13; rank++) {
+            for (uint8_t copy = 0; copy < table_counts[suit][rank]; copy++) {
+                info.tableCards.push_back(Card{suit, rank});
+            }
+        }
+    }
+    
+    observers.clear();
+    for (uint64_t seat = 0; seat < player_hands.size(); seat++) {
+        auto it = player_strategies.find(seat);
+        if (it == player_strategies.end()) continue;
+        
+        PlayerStrategy* strategy = it->second.get();
+        info.seat = seat;
+        info.hand = player_hands[seat];
+        strategy->onGameStart(info);
+        
+        // Build the dispatch list once per game so the hot loop never asks again
+        if (strategy->wantsObservations() &&
+            std::find(observers.begin(), observers.end(), strategy) == observers.end()) {
+            observers.push_back(strategy);
+        }
+    }
+}
+
+void MyGameMapper::notifyGameEnd(const std::vector<std::pair<uint64_t, uint64_t>>& rankings) {
+    for (const auto& result : rankings) {
+        auto it = player_strategies.find(result.first);
+        if (it != player_strategies.end()) {
+            it->second->onGameEnd(result.second);
+        }
+    }
+}
+
+void MyGameMapper::dispatchMove(uint64_t playerID, const Card& card) {
+    for (PlayerStrategy* observer : observers) {
+        observer->observeMove(playerID, card);
+    }
 }
 
-void MyGameMapper::dealCards() {
-    // Create a deck of cards
-    std::vector<Card> deck;
-    for (const auto& pair : cards_hashmap) {
-        deck.push_back(pair.second);
+void MyGameMapper::dispatchPass(uint64_t playerID) {
+    for (PlayerStrategy* observer : observers) {
+        observer->observePass(playerID);
     }
+}
+
+void MyGameMapper::dealCards(uint64_t seed, std::vector<PackedCard>& cards,
+                             std::vector<std::vector<Card>>& hands) const {
+    // Copies laid out at the start (the 7s) are not dealt again
+    std::array<uint8_t, PackedCard::kCount> on_table{};
+    for (const Card& card : rules.startCards) on_table[PackedCard(card).id]++;
     
-    // Shuffle the deck
-    std::shuffle(deck.begin(), deck.end(), rng);
+    // Create the deck(s) in card-ID order so a seed always gives the same deal;
+    // one byte per card keeps the shuffle cheap
+    cards.clear();
+    for (const PackedCard card : card_order) {
+        for (uint64_t copy = on_table[card.id]; copy < rules.numDecks; copy++) {
+            cards.push_back(card);
+        }
+    }
     
-    // Deal to players
-    for (size_t i = 0; i < deck.size(); i++) {
-        player_hands[i % player_hands.size()].push_back(deck[i]);
+    // Shuffle the cards with the per-deal engine
+    std::mt19937_64 deal_rng(seed);
+    std::shuffle(cards.begin(), cards.end(), deal_rng);
+    
+    // Deal contiguous hands; the remainder goes to the seats chosen by the rules
+    const size_t numPlayers = hands.size();
+    const size_t base = cards.size() / numPlayers;
+    const size_t extra = cards.size() % numPlayers;
+    size_t next = 0;
+    for (size_t seat = 0; seat < numPlayers; seat++) {
+        bool gets_extra = (rules.unevenDeal == UnevenDeal::FrontSeats)
+            ? seat < extra
+            : seat >= numPlayers - extra;
+        size_t count = base + (gets_extra ? 1 : 0);
+        hands[seat].clear();
+        for (size_t i = next; i < next + count; i++) {
+            hands[seat].push_back(cards[i].card());
+        }
+        next += count;
+    }
+}
+
+void MyGameMapper::dealFromFile() {
+    deal_file->get(deal_seed, file_deal);
+    if (file_deal.hands.size() != player_hands.size()) {
+        throw std::runtime_error("Deal " + std::to_string(deal_seed) + " is for " +
+                                 std::to_string(file_deal.hands.size()) + " players, not " +
+                                 std::to_string(player_hands.size()));
+    }
+    
+    // Every copy must exist in the deck(s) and not already be on the table...
+    TableCounts used = table_counts;
+    uint64_t dealt = 0;
+    for (const std::vector<Card>& hand : file_deal.hands) {
+        for (const Card& card : hand) {
+            if (card.suit > 3 || card.rank > 13 || ++used[card.suit][card.rank] > rules.numDecks) {
+                throw std::runtime_error("Deal " + std::to_string(deal_seed) +
+                                         " does not fit the table rules");
+            }
+        }
+        dealt += hand.size();
+    }
+    // ...and, as in a shuffled deal, the hands must hold every card not on the table
+    const uint64_t onTable = rules.startCards.size();
+    if (dealt + onTable != 52 * rules.numDecks) {
+        throw std::runtime_error("Deal " + std::to_string(deal_seed) + " is incomplete: " +
+                                 std::to_string(dealt) + " cards in hand and " + std::to_string(onTable) +
+                                 " on the table, expected " + std::to_string(52 * rules.numDecks));
+    }
+    for (size_t seat = 0; seat < player_hands.size(); seat++) {
+        player_hands[seat] = file_deal.hands[seat];
     }
 }
 
 void MyGameMapper::initializeTable() {
     // Clear the table layout
     table_cards.clear();
+    for (auto& row : table_counts) row.fill(0);
     
     // Start with no cards played
     for (int suit = 0; suit < 4; suit++) {
@@ -160,90 +401,129 @@ void MyGameMapper::initializeTable() {
         for (int rank = 1; rank <= 13; rank++) {
             table_cards[suit][rank] = false;
         }
-        
-        // In Sevens, start with 7s on the table
-        table_cards[suit][7] = true;
+    }
+    
+    // In Sevens, start with 7s on the table; house rules may lay out other cards
+    for (const Card& card : rules.startCards) {
+        table_cards[card.suit][card.rank] = true;
+        table_counts[card.suit][card.rank]++;
     }
 }
 
-bool MyGameMapper::isGameOver() {
-    // Check if any player has no cards left
-    for (const auto& hand : player_hands) {
-        if (hand.empty()) {
-            return true;
+bool MyGameMapper::startTurn(size_t player_id, bool verbose) {
+    // Get valid moves (only the opening card on the very first turn, if the rules say so)
+    std::vector<Card>& valid_moves = valid_moves_buffer;
+    if (state.firstCardPending()) {
+        valid_moves.assign(1, rules.firstCard);
+    } else if (rules.numDecks == 1) {
+        // The state's move mask, listed in hand order
+        const uint64_t legal = state.legalMoves(state_rules);
+        valid_moves.clear();
+        if (legal) {
+            for (const Card& card : player_hands[player_id]) {
+                if (legal & PackedCard(card).bit()) valid_moves.push_back(card);
+            }
         }
+    } else {
+        move_gen.collect(table_counts, player_hands[player_id], valid_moves);
     }
-    return false;
+    
+    // If no valid moves, pass
+    if (valid_moves.empty()) {
+        if (verbose) {
+            std::cout << "Player " << player_id << " has no valid moves and passes.\n";
+        }
+        if (rules.passPenalty > 0) {
+            chip_balances[player_id] -= rules.passPenalty;
+            pot += rules.passPenalty;
+        }
+        stats.passes[player_id]++;
+        state.pass();
+        dispatchPass(player_id);
+        return false;
+    }
+    return true;
 }
 
-void MyGameMapper::playRound(bool verbose) {
-    // For each player
-    for (size_t player_id = 0; player_id < player_hands.size(); player_id++) {
-        // If player has no cards, skip
-        if (player_hands[player_id].empty()) continue;
-        
-        // Get valid moves
-        std::vector<Card> valid_moves = getValidMoves(player_id);
-        
-        // If no valid moves, skip
-        if (valid_moves.empty()) {
-            if (verbose) {
-                std::cout << "Player " << player_id << " has no valid moves and passes.\n";
-            }
-            continue;
-        }
-        
-        // Choose move based on strategy
-        Card chosen_move;
-        if (player_strategies.count(player_id) > 0) {
-            // chosen_move = player_strategies[player_id]->chooseMove(valid_moves, table_cards);
-        
+void MyGameMapper::beginGame(uint64_t numPlayers, bool verbose) {
+    setupGame(numPlayers);
+    notifyGameStart();
+    step_verbose = verbose;
+}
 
-            int move_index = player_strategies[player_id]->selectCardToPlay(valid_moves, table_cards);
-            if (move_index >= 0 && move_index < valid_moves.size()) {
-                chosen_move = valid_moves[move_index];
+bool MyGameMapper::nextDecision(uint64_t& seat) {
+    // The state skips empty hands and ends the game between rounds
+    while (!state.over()) {
+        const size_t player_id = state.toMove();
+        if (startTurn(player_id, step_verbose)) {
+            // Nothing to decide: skip the strategy call
+            if (forced_shortcut && valid_moves_buffer.size() == 1) {
+                stats.forced[player_id]++;
+                playChosen(player_id, valid_moves_buffer[0]);
+                continue;
             }
-        
-        
-        } else {
-            // Default strategy: random
-            std::uniform_int_distribution<size_t> dist(0, valid_moves.size() - 1);
-            chosen_move = valid_moves[dist(rng)];
+            pending_seat = player_id;
+            seat = player_id;
+            stats.decisions[player_id]++;
+            return true;
         }
-        
-        // Make the move
-        makeMove(player_id, chosen_move, verbose);
     }
+    stats.rounds = state.rounds();
+    return false;
 }
 
-std::vector<Card> MyGameMapper::getValidMoves(size_t player_id) {
-    std::vector<Card> valid_moves;
-    
-    // Check each card in the player's hand
-    for (const Card& card : player_hands[player_id]) {
-        // Check if card is valid (playable on table)
-        if (isValidMove(card)) {
-            valid_moves.push_back(card);
-        }
+const std::vector<Card>& MyGameMapper::pendingMoves() const {
+    return valid_moves_buffer;
+}
+
+const std::vector<Card>& MyGameMapper::getHand(uint64_t seat) const {
+    return player_hands[seat];
+}
+
+const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& MyGameMapper::getTableLayout() const {
+    return table_cards;
+}
+
+void MyGameMapper::applyDecision(int moveIndex) {
+    playChosen(pending_seat, resolveMove(pending_seat, moveIndex));
+}
+
+Card MyGameMapper::resolveMove(size_t player_id, int move_index) {
+    // One unsigned compare covers negative and too-large indices
+    if (static_cast<size_t>(move_index) < valid_moves_buffer.size()) [[likely]] {
+        return valid_moves_buffer[move_index];
     }
     
-    return valid_moves;
+    illegal_moves[player_id]++;
+    if (illegal_policy == IllegalMovePolicy::Throw) {
+        throw std::out_of_range("Move index " + std::to_string(move_index) + " is not a valid move for player " +
+                                std::to_string(player_id));
+    }
+    size_t substitute = 0;
+    if (illegal_policy == IllegalMovePolicy::PlayRandom) {
+        std::uniform_int_distribution<size_t> dist(0, valid_moves_buffer.size() - 1);
+        substitute = dist(rng);
+    }
+    if (step_verbose) {
+        std::cout << "Player " << player_id << " returned illegal move index " << move_index
+                  << "; playing " << valid_moves_buffer[substitute] << " instead.\n";
+    }
+    return valid_moves_buffer[substitute];
 }
 
-bool MyGameMapper::isValidMove(const Card& card) {
-    // In Sevens, a card is valid if:
-    // 1. It is a 7, or
-    // 2. It is adjacent to a card already on table
-    
-    if (card.rank == 7) return true;
-    
-    if (card.rank < 7) {
-        // Check if rank+1 is on table
-        return table_cards[card.suit][card.rank + 1];
-    } else {
-        // Check if rank-1 is on table
-        return table_cards[card.suit][card.rank - 1];
+void MyGameMapper::playChosen(size_t player_id, const Card& card) {
+    makeMove(player_id, card, step_verbose);
+    stats.turns++;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> MyGameMapper::endGame() {
+    auto rankings = getFinalRankings();
+    for (size_t seat = 0; seat < player_hands.size(); seat++) {
+        stats.cardsLeft[seat] = player_hands[seat].size();
     }
+    settleChips(rankings, step_verbose);
+    notifyGameEnd(rankings);
+    return rankings;
 }
 
 void MyGameMapper::makeMove(size_t player_id, const Card& card, bool verbose) {
@@ -261,27 +541,72 @@ void MyGameMapper::makeMove(size_t player_id, const Card& card, bool verbose) {
     
     // Add card to table
     table_cards[card.suit][card.rank] = true;
+    table_counts[card.suit][card.rank]++;
+    
+    // An empty hand takes the next placement; the state also moves on to the next seat
+    state.play(PackedCard(card));
+    if (verbose && player_hands[player_id].empty()) {
+        std::cout << "Player " << player_id << " finishes in position "
+                  << static_cast<int>(state.finished()) << std::endl;
+    }
+    
+    // Let every observing seat see the move
+    dispatchMove(player_id, card);
+}
+
+void MyGameMapper::settleChips(const std::vector<std::pair<uint64_t, uint64_t>>& rankings, bool verbose) {
+    if (rules.passPenalty == 0 && rules.cardPenalty == 0) return;
+    
+    // Cards still held are paid for, then the pot is shared by the rank-1 seat(s)
+    std::vector<uint64_t> winners;
+    for (const auto& result : rankings) {
+        const int64_t cards_left = static_cast<int64_t>(player_hands[result.first].size());
+        chip_balances[result.first] -= cards_left * rules.cardPenalty;
+        pot += cards_left * rules.cardPenalty;
+        if (result.second == 1) winners.push_back(result.first);
+    }
+    for (size_t i = 0; i < winners.size(); i++) {
+        int64_t share = pot / static_cast<int64_t>(winners.size());
+        if (i == 0) share += pot % static_cast<int64_t>(winners.size());
+        chip_balances[winners[i]] += share;
+    }
+    
+    if (verbose) {
+        std::cout << "Pot of " << pot << " chip(s) goes to player " << winners.front() << std::endl;
+    }
+    pot = 0;
 }
 
 std::vector<std::pair<uint64_t, uint64_t>> MyGameMapper::getFinalRankings() {
     std::vector<std::pair<uint64_t, uint64_t>> rankings;
     
-    // Count remaining cards for each player
+    // Players who went out are placed in the order they finished
+    for (size_t i = 0; i < state.finished(); i++) {
+        rankings.push_back({state.finish_order[i], i + 1});
+    }
+    
+    // Everybody else by cards left; stable_sort over seat order makes ties deterministic
     std::vector<std::pair<uint64_t, uint64_t>> player_cards;
     for (size_t i = 0; i < player_hands.size(); i++) {
-        player_cards.push_back({i, player_hands[i].size()});
+        if (!player_hands[i].empty()) {
+            player_cards.push_back({i, player_hands[i].size()});
+        }
     }
-    
-    // Sort by card count (ascending)
-    std::sort(player_cards.begin(), player_cards.end(),
-              [](const auto& a, const auto& b) { return a.second < b.second; });
+    std::stable_sort(player_cards.begin(), player_cards.end(),
+                     [](const auto& a, const auto& b) { return a.second < b.second; });
     
     // Assign ranks (1 = winner, etc.)
+    const uint64_t first_rank = state.finished() + 1;
     for (size_t i = 0; i < player_cards.size(); i++) {
-        rankings.push_back({player_cards[i].first, i + 1});
+        uint64_t rank = first_rank + i;
+        if (rules.tieBreak == TieBreak::SharedRank && i > 0 &&
+            player_cards[i].second == player_cards[i - 1].second) {
+            rank = rankings.back().second;
+        }
+        rankings.push_back({player_cards[i].first, rank});
     }
     
     return rankings;
 }
 
-} // namespace sevens
\ No newline at end of file
+} // namespace sevens
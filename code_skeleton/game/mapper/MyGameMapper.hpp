@@ -2,6 +2,12 @@
 
 #include "Generic_game_mapper.hpp"
 #include "../../strat/PlayerStrategy.hpp"
+#include "../../card/DealFile.hpp"
+#include "../../card/PackedCard.hpp"
+#include "../rules/GameRules.hpp"
+#include "../rules/GameState.hpp"
+#include "../rules/MoveGenerator.hpp"
+#include <array>
 #include <random>
 #include <unordered_map>
 #include <vector>
@@ -10,6 +16,36 @@
 
 namespace sevens {
 
+/**
+ * What the engine does when a strategy returns an index outside its valid moves.
+ *   Throw:      std::out_of_range naming the seat and index (the game is abandoned)
+ *   PlayRandom: substitute a uniformly random valid move
+ *   PlayFirst:  substitute the first valid move (deterministic)
+ * Every illegal answer is counted per seat either way.
+ */
+enum class IllegalMovePolicy {
+    Throw,
+    PlayRandom,
+    PlayFirst
+};
+
+/**
+ * Per-game counters kept by the engine (see getLastGameStats()). The
+ * per-seat vectors are indexed by seat.
+ */
+struct GameStats {
+    uint64_t dealSeed = 0;
+    uint64_t turns = 0;   // Cards played
+    uint64_t rounds = 0;  // Rounds started, including the last partial one
+    std::vector<uint64_t> passes;
+    std::vector<uint64_t> decisions;  // Moves chosen by the seat's strategy
+    std::vector<uint64_t> forced;     // Single-move turns played by the engine (see setForcedMoveShortcut)
+    std::vector<uint64_t> cardsLeft;  // Filled in by endGame()
+    // Time spent in selectCardToPlay; only with setDecisionTiming(true) and
+    // only for games played by compute_game_progress()
+    std::vector<uint64_t> decisionNanos;
+};
+
 /**
  * Enhanced Sevens simulation with strategy support:
  *  - Possibly internal mode or competition mode
@@ -39,25 +75,117 @@ public:
     void registerStrategy(uint64_t playerID, std::shared_ptr<PlayerStrategy> strategy);
     bool hasRegisteredStrategies() const;
 
+    // Deal seeding: by default every game draws a fresh seed from the
+    // mapper's engine; setDealSeed() pins the seed of the next game.
+    void setDealSeed(uint64_t seed);
+    uint64_t getLastDealSeed() const;
+
+    // Predefined deals loaded by read_cards(path): useDeal(i) makes the next
+    // game replay deal i (reported to strategies as its dealSeed)
+    uint64_t getDealCount() const;
+    void useDeal(uint64_t index);
+    // The loaded deal file itself, or nullptr for random deals
+    std::shared_ptr<const DealFile> getDealFile() const { return deal_file; }
+
+    // The hands a game with this seed would start from (for offline analysis);
+    // leaves the mapper and any game in progress untouched
+    Deal previewDeal(uint64_t numPlayers, uint64_t seed) const;
+
+    // Table rules: player count limits, decks, uneven deals, tie handling and
+    // layout variants. read_game(filename) loads them from a rules file.
+    void setRules(const GameRules& newRules);
+    const GameRules& getRules() const;
+
+    // Net chips won or lost by each seat in the last game (pass/card penalties)
+    const std::vector<int64_t>& getChipBalances() const;
+
+    // Handling of out-of-range move indices (default PlayRandom), and how many
+    // each seat returned in the last game
+    void setIllegalMovePolicy(IllegalMovePolicy policy);
+    IllegalMovePolicy getIllegalMovePolicy() const;
+    const std::vector<uint64_t>& getIllegalMoveCounts() const;
+
+    // With exactly one legal move the engine plays it without asking the
+    // strategy (default on). Observers still see the move. Turn it off to
+    // check what strategies answer in forced positions.
+    void setForcedMoveShortcut(bool enabled);
+    bool getForcedMoveShortcut() const;
+
+    // Counters of the last (or current) game; timing costs two clock reads
+    // per decision, so it is off by default
+    const GameStats& getLastGameStats() const;
+    void setDecisionTiming(bool enabled);
+
+    // Stepwise play for drivers that cannot block inside selectCardToPlay
+    // (see game/async): beginGame(), then nextDecision()/applyDecision() until
+    // nextDecision() returns false, then endGame() for the rankings. Passes
+    // and forced moves are handled inside nextDecision(); registered strategies still get
+    // their lifecycle and observation calls, but are not asked for moves.
+    // applyDecision() handles bad indices by the illegal-move policy.
+    void beginGame(uint64_t numPlayers, bool verbose = false);
+    bool nextDecision(uint64_t& seat);
+    const std::vector<Card>& pendingMoves() const;
+    const std::vector<Card>& getHand(uint64_t seat) const;
+    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& getTableLayout() const;
+    void applyDecision(int moveIndex);
+    std::vector<std::pair<uint64_t, uint64_t>> endGame();
 
 private:
     std::default_random_engine rng;
+    GameRules rules;
+    MoveGenerator move_gen;  // Specialised for `rules` whenever they change
+    StateRules state_rules;  // Likewise, for `state`
+    uint64_t deal_seed = 0;
+    bool deal_seed_pinned = false;
+    std::shared_ptr<const DealFile> deal_file;
+    bool deal_from_file = false;
+    Deal file_deal;
     std::unordered_map<uint64_t, std::shared_ptr<PlayerStrategy>> player_strategies;
+    // Strategies that receive observeMove/observePass, in seat order (one entry per object)
+    std::vector<PlayerStrategy*> observers;
     std::vector<std::vector<Card>> player_hands;
+    // Cards of cards_hashmap in card-ID order (set by read_cards), and the deck being dealt
+    std::vector<PackedCard> card_order;
+    std::vector<PackedCard> deck;
     // std::vector<std::vector<bool>> table_cards;
     std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>> table_cards;
+    // Copies of each card on the table; drives move checks with several decks
+    TableCounts table_counts{};
+    // Hands, table and turn order of the game in progress (the same state search uses);
+    // its card masks drive move checks with a single deck
+    GameState state;
+    std::vector<int64_t> chip_balances;
+    int64_t pot = 0;
+    IllegalMovePolicy illegal_policy = IllegalMovePolicy::PlayRandom;
+    std::vector<uint64_t> illegal_moves;
+    GameStats stats;
+    bool time_decisions = false;
+    bool forced_shortcut = true;
+    std::vector<Card> valid_moves_buffer;
+    GameStartInfo start_info;  // Reused by notifyGameStart()
+    // Seat awaiting a move in stepwise play
+    size_t pending_seat = 0;
+    bool step_verbose = false;
 
 
     
     // Helper methods
+    std::vector<std::pair<uint64_t, uint64_t>> runGame(uint64_t numPlayers, bool verbose);
     void setupGame(uint64_t numPlayers);
-    void dealCards();
+    void notifyGameStart();
+    void notifyGameEnd(const std::vector<std::pair<uint64_t, uint64_t>>& rankings);
+    void dispatchMove(uint64_t playerID, const Card& card);
+    void dispatchPass(uint64_t playerID);
+    // Shuffle the cards not laid out at the start with `seed` and deal them
+    // into `hands` (already sized to the seat count); `cards` is scratch space
+    void dealCards(uint64_t seed, std::vector<PackedCard>& cards, std::vector<std::vector<Card>>& hands) const;
+    void dealFromFile();
     void initializeTable();
-    bool isGameOver();
-    void playRound(bool verbose);
-    std::vector<Card> getValidMoves(size_t player_id);
-    bool isValidMove(const Card& card);
+    bool startTurn(size_t player_id, bool verbose);
+    void playChosen(size_t player_id, const Card& card);
+    Card resolveMove(size_t player_id, int move_index);
     void makeMove(size_t player_id, const Card& card, bool verbose);
+    void settleChips(const std::vector<std::pair<uint64_t, uint64_t>>& rankings, bool verbose);
     std::vector<std::pair<uint64_t, uint64_t>> getFinalRankings();
 
 
@@ -0,0 +1,135 @@
+#include "Metrics.hpp"
+#include <sstream>
+#include <stdexcept>
+
+namespace sevens {
+
+uint64_t LatencyHistogram::Snapshot::quantile(double q) const {
+    if (count == 0) return 0;
+    const uint64_t target = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; b++) {
+        seen += buckets[b];
+        if (seen >= target) return b == 0 ? 0 : 1ULL << b;
+    }
+    return UINT64_MAX;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot result;
+    for (const Shard& shard : shards) {
+        for (int b = 0; b < kBuckets; b++) {
+            const uint64_t n = shard.buckets[b].load(std::memory_order_relaxed);
+            result.buckets[b] += n;
+            result.count += n;
+        }
+        const uint64_t overflow = shard.overflow.load(std::memory_order_relaxed);
+        result.overflow += overflow;
+        result.count += overflow;
+        result.sum_ns += shard.sum_ns.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, Kind kind) {
+    auto it = families.find(name);
+    if (it == families.end()) {
+        it = families.emplace(name, Family{kind, help, {}, {}, {}}).first;
+    } else if (it->second.kind != kind) {
+        throw std::invalid_argument("Metric " + name + " registered with two types");
+    }
+    return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = family(name, help, Kind::Counter).counters[labels];
+    if (!slot) slot = std::make_unique<Counter>();
+    return *slot;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = family(name, help, Kind::Gauge).gauges[labels];
+    if (!slot) slot = std::make_unique<Gauge>();
+    return *slot;
+}
+
+LatencyHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                             const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& slot = family(name, help, Kind::Histogram).histograms[labels];
+    if (!slot) slot = std::make_unique<LatencyHistogram>();
+    return *slot;
+}
+
+std::string MetricsRegistry::label(const std::string& key, const std::string& value) {
+    std::string result = key + "=\"";
+    for (char c : value) {
+        if (c == '\\' || c == '"') result += '\\';
+        if (c == '\n') {
+            result += "\\n";
+            continue;
+        }
+        result += c;
+    }
+    return result + "\"";
+}
+
+void MetricsRegistry::addCollector(std::function<void()> collector) {
+    std::lock_guard<std::mutex> lock(mutex);
+    collectors.push_back(std::move(collector));
+}
+
+std::string MetricsRegistry::render() {
+    // Collectors may register new series, so they run without the lock
+    std::vector<std::function<void()>> toRun;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        toRun = collectors;
+    }
+    for (const auto& collector : toRun) collector();
+
+    std::ostringstream out;
+    out.precision(10);
+    auto series = [](const std::string& name, const std::string& labels) {
+        return labels.empty() ? name : name + "{" + labels + "}";
+    };
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [name, family] : families) {
+        out << "# HELP " << name << " " << family.help << "\n";
+        if (family.kind == Kind::Counter) {
+            out << "# TYPE " << name << " counter\n";
+            for (const auto& [labels, counter] : family.counters) {
+                out << series(name, labels) << " " << counter->value() << "\n";
+            }
+        } else if (family.kind == Kind::Gauge) {
+            out << "# TYPE " << name << " gauge\n";
+            for (const auto& [labels, gauge] : family.gauges) {
+                out << series(name, labels) << " " << gauge->value() << "\n";
+            }
+        } else {
+            out << "# TYPE " << name << " histogram\n";
+            for (const auto& [labels, histogram] : family.histograms) {
+                const LatencyHistogram::Snapshot snapshot = histogram->snapshot();
+                const std::string prefix = labels.empty() ? "" : labels + ",";
+                // Fixed boundaries from 128 ns up, so every scrape has the same buckets;
+                // overflow samples only show up in +Inf
+                uint64_t cumulative = 0;
+                for (int b = 0; b < LatencyHistogram::kBuckets; b++) {
+                    cumulative += snapshot.buckets[b];
+                    if (b < 7) continue;
+                    const double le = static_cast<double>(1ULL << b) * 1e-9;
+                    out << name << "_bucket{" << prefix << "le=\"" << le << "\"} " << cumulative << "\n";
+                }
+                out << name << "_bucket{" << prefix << "le=\"+Inf\"} " << snapshot.count << "\n";
+                out << series(name + "_sum", labels) << " " << static_cast<double>(snapshot.sum_ns) * 1e-9 << "\n";
+                out << series(name + "_count", labels) << " " << snapshot.count << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+} // namespace sevens
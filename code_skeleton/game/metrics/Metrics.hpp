@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+namespace metrics_detail {
+
+constexpr size_t kShards = 16;
+
+// Small per-thread index: threads mostly update their own shard, so hot
+// counters never bounce a cache line between cores
+inline size_t shardIndex() {
+    static std::atomic<size_t> next{0};
+    thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+}
+
+} // namespace metrics_detail
+
+/**
+ * Monotonic count, sharded per thread. add() is one relaxed atomic add on
+ * the caller's shard; value() sums the shards (for scrapes).
+ */
+class Counter {
+public:
+    void add(uint64_t n = 1) {
+        shards[metrics_detail::shardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t value() const {
+        uint64_t total = 0;
+        for (const Shard& shard : shards) total += shard.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    Shard shards[metrics_detail::kShards];
+};
+
+// Last value set wins (rates, memory, progress)
+class Gauge {
+public:
+    void set(double v) { value_.store(v, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * Durations in nanoseconds, bucketed by powers of two: bucket b counts
+ * values below 2^b ns (bucket 0 is exactly 0). Longer durations go to a
+ * separate overflow count with no finite bound. Sharded like Counter.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kBuckets = 40;  // Up to 2^39 ns, about 9 minutes
+
+    void observe(uint64_t ns) {
+        Shard& shard = shards[metrics_detail::shardIndex()];
+        const int bucket = std::bit_width(ns);
+        if (bucket < kBuckets) shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        else shard.overflow.fetch_add(1, std::memory_order_relaxed);
+        shard.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    struct Snapshot {
+        uint64_t buckets[kBuckets] = {};
+        uint64_t overflow = 0;  // 2^(kBuckets - 1) ns or more; included in count
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        // Upper bound of the bucket holding quantile q (0 if empty, UINT64_MAX in overflow)
+        uint64_t quantile(double q) const;
+    };
+    Snapshot snapshot() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> buckets[kBuckets] = {};
+        std::atomic<uint64_t> overflow{0};
+        std::atomic<uint64_t> sum_ns{0};
+    };
+    Shard shards[metrics_detail::kShards];
+};
+
+/**
+ * Named metrics rendered in the Prometheus text exposition format.
+ *
+ * Metrics are created once (under a lock) and then updated through the
+ * returned references, which stay valid for the registry's lifetime; the
+ * hot path never locks. A name plus label set identifies one series, e.g.
+ * counter("sevens_games_total", "...") or
+ * gauge("sevens_win_rate", "...", "strategy=\"greedy\",window=\"60s\"").
+ * Collectors run at the start of every render() and may refresh gauges
+ * computed from other metrics (rates, windows, memory).
+ */
+class MetricsRegistry {
+public:
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    // Rendered in seconds, as Prometheus expects
+    LatencyHistogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    void addCollector(std::function<void()> collector);
+
+    std::string render();
+
+    // `key="value"` with the value escaped for the text format
+    static std::string label(const std::string& key, const std::string& value);
+
+private:
+    enum class Kind { Counter, Gauge, Histogram };
+
+    struct Family {
+        Kind kind;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms;
+    };
+
+    std::mutex mutex;
+    std::map<std::string, Family> families;
+    std::vector<std::function<void()>> collectors;
+
+    Family& family(const std::string& name, const std::string& help, Kind kind);
+};
+
+} // namespace sevens
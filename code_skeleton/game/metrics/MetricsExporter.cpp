@@ -0,0 +1,139 @@
+#include "MetricsExporter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace sevens {
+
+MetricsExporter::MetricsExporter(MetricsRegistry& registry, std::string filePath, std::chrono::milliseconds period,
+                                 int httpPort)
+    : registry(registry), file_path(std::move(filePath)), period(period)
+{
+    if (httpPort >= 0) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(httpPort));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int reuse = 1;
+        if (listen_fd >= 0) ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (listen_fd < 0 || ::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listen_fd, 16) != 0) {
+            const std::string reason = std::strerror(errno);
+            if (listen_fd >= 0) ::close(listen_fd);
+            throw std::runtime_error("Could not serve metrics on 127.0.0.1:" + std::to_string(httpPort) + ": " +
+                                     reason);
+        }
+    }
+    if (::pipe2(wake_pipe, O_CLOEXEC) != 0) {
+        if (listen_fd >= 0) ::close(listen_fd);
+        throw std::runtime_error("Could not create the metrics exporter: " + std::string(std::strerror(errno)));
+    }
+    worker = std::thread(&MetricsExporter::run, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+    stopping = true;
+    ssize_t ignored = ::write(wake_pipe[1], "x", 1);
+    (void)ignored;
+    worker.join();
+    if (!file_path.empty()) {
+        try {
+            writeFile();
+        } catch (const std::exception& e) {
+            std::cerr << "[MetricsExporter] " << e.what() << "\n";
+        }
+    }
+    if (listen_fd >= 0) ::close(listen_fd);
+    ::close(wake_pipe[0]);
+    ::close(wake_pipe[1]);
+}
+
+void MetricsExporter::writeFile() {
+    const std::string text = registry.render();
+    const std::string temp = file_path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        out << text;
+        if (!out) {
+            throw std::runtime_error("Could not write metrics file: " + temp);
+        }
+    }
+    if (std::rename(temp.c_str(), file_path.c_str()) != 0) {
+        throw std::runtime_error("Could not replace metrics file: " + file_path);
+    }
+}
+
+void MetricsExporter::run() {
+    auto next = std::chrono::steady_clock::now() + period;
+    while (!stopping) {
+        pollfd fds[2] = {{wake_pipe[0], POLLIN, 0}, {listen_fd, POLLIN, 0}};
+        const int wait = file_path.empty() ? -1 : static_cast<int>(std::max<int64_t>(0,
+            std::chrono::duration_cast<std::chrono::milliseconds>(next - std::chrono::steady_clock::now()).count()));
+        const int ready = ::poll(fds, listen_fd >= 0 ? 2 : 1, wait);
+        if (stopping) break;
+
+        if (ready > 0 && (fds[1].revents & POLLIN)) {
+            const int client = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client >= 0) {
+                serve(client);
+                ::close(client);
+            }
+        }
+        if (!file_path.empty() && std::chrono::steady_clock::now() >= next) {
+            try {
+                writeFile();
+            } catch (const std::exception& e) {
+                std::cerr << "[MetricsExporter] " << e.what() << "\n";  // A full disk should not end the run
+            }
+            next += period;
+        }
+    }
+}
+
+void MetricsExporter::serve(int fd) {
+    // A scraper that stalls must not block the exporter for long
+    timeval limit{1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &limit, sizeof(limit));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &limit, sizeof(limit));
+
+    std::string request;
+    char chunk[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return;
+        request.append(chunk, static_cast<size_t>(n));
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+    if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0) {
+        body = registry.render();
+    } else {
+        status = "404 Not Found";
+        body = "Try GET /metrics\n";
+    }
+    const std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                                 "Content-Length: " + std::to_string(body.size()) +
+                                 "\r\nConnection: close\r\n\r\n" + body;
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t n = ::send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return;
+        sent += static_cast<size_t>(n);
+    }
+}
+
+} // namespace sevens
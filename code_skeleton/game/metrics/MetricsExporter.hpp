@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Metrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace sevens {
+
+/**
+ * Publishes a MetricsRegistry from a background thread, in either or both
+ * of two ways:
+ *  - every `period`, render it to `filePath` (written to a temporary file
+ *    and renamed, so a reader such as node_exporter's textfile collector
+ *    never sees half a file), plus once more on shutdown;
+ *  - serve GET /metrics on 127.0.0.1:httpPort. Each scrape renders afresh.
+ *
+ * Every render also runs the registry's collectors, which is what
+ * advances RunMetrics' rates and windows. So keep a file exporter, or
+ * regular scrapes, running for those.
+ */
+class MetricsExporter {
+public:
+    // Empty filePath: no file; httpPort < 0: no HTTP. Throws std::runtime_error
+    // if the port cannot be bound.
+    MetricsExporter(MetricsRegistry& registry, std::string filePath, std::chrono::milliseconds period,
+                    int httpPort = -1);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Render to the file now (also done by the destructor)
+    void writeFile();
+
+private:
+    MetricsRegistry& registry;
+    std::string file_path;
+    std::chrono::milliseconds period;
+    int listen_fd = -1;
+    int wake_pipe[2] = {-1, -1};
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+
+    void run();
+    void serve(int fd);
+};
+
+} // namespace sevens
@@ -0,0 +1,128 @@
+#include "RunMetrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace sevens {
+
+namespace {
+
+// VmRSS / VmHWM from /proc/self/status, in bytes (0 where unavailable)
+void readMemory(uint64_t& resident, uint64_t& peak) {
+    resident = peak = 0;
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        uint64_t kilobytes = 0;
+        fields >> key >> kilobytes;
+        if (key == "VmRSS:") resident = kilobytes * 1024;
+        else if (key == "VmHWM:") peak = kilobytes * 1024;
+    }
+}
+
+} // namespace
+
+RunMetrics::RunMetrics(MetricsRegistry& registry, std::vector<uint64_t> windowSeconds)
+    : registry(registry), windows(std::move(windowSeconds)),
+      games(registry.counter("sevens_games_total", "Games finished"))
+{
+    registry.addCollector([this]() { collect(); });
+}
+
+RunMetrics::StrategyMetrics& RunMetrics::strategy(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name) return *strategies[i];
+    }
+    const std::string labels = MetricsRegistry::label("strategy", name);
+    names.push_back(name);
+    strategies.push_back(std::unique_ptr<StrategyMetrics>(new StrategyMetrics{
+        registry.counter("sevens_seat_games_total", "Games played per strategy (one per seat)", labels),
+        registry.counter("sevens_wins_total", "Games won per strategy", labels),
+        registry.counter("sevens_rank_sum_total", "Sum of final ranks per strategy", labels),
+        registry.histogram("sevens_decision_seconds", "Time per move decision", labels)}));
+    return *strategies.back();
+}
+
+void RunMetrics::wilson(uint64_t wins, uint64_t n, double& lower, double& upper) {
+    if (n == 0) {
+        lower = 0.0;
+        upper = 1.0;
+        return;
+    }
+    const double z = 1.959964;
+    const double p = static_cast<double>(wins) / n;
+    const double z2n = z * z / n;
+    const double center = (p + z2n / 2) / (1 + z2n);
+    const double half = z * std::sqrt(p * (1 - p) / n + z2n / (4 * n)) / (1 + z2n);
+    lower = std::max(0.0, center - half);
+    upper = std::min(1.0, center + half);
+}
+
+void RunMetrics::collect() {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Sample sample{now, games.value(), {}};
+    for (const auto& metrics : strategies) sample.seats.emplace_back(metrics->games.value(), metrics->wins.value());
+
+    const double uptime = std::chrono::duration<double>(now - started).count();
+    registry.gauge("sevens_uptime_seconds", "Seconds since the run started").set(uptime);
+    if (!samples.empty()) {
+        const double dt = std::chrono::duration<double>(now - samples.back().time).count();
+        if (dt > 0) {
+            registry.gauge("sevens_games_per_second", "Games finished per second since the previous scrape")
+                .set(static_cast<double>(sample.games - samples.back().games) / dt);
+        }
+    }
+
+    // One series per strategy and window
+    auto publish = [&](size_t index, const std::string& window, uint64_t n, uint64_t wins) {
+        const std::string labels =
+            MetricsRegistry::label("strategy", names[index]) + "," + MetricsRegistry::label("window", window);
+        double lower, upper;
+        wilson(wins, n, lower, upper);
+        registry.gauge("sevens_win_rate", "Win rate per strategy over a window", labels)
+            .set(n ? static_cast<double>(wins) / n : 0.0);
+        registry.gauge("sevens_win_rate_lower", "Lower end of the 95% Wilson interval of sevens_win_rate", labels)
+            .set(lower);
+        registry.gauge("sevens_win_rate_upper", "Upper end of the 95% Wilson interval of sevens_win_rate", labels)
+            .set(upper);
+    };
+    for (size_t i = 0; i < sample.seats.size(); i++) {
+        publish(i, "total", sample.seats[i].first, sample.seats[i].second);
+        for (uint64_t seconds : windows) {
+            // Newest sample at least a window old; a younger run counts from zero
+            const auto since = now - std::chrono::seconds(seconds);
+            const Sample* base = nullptr;
+            for (const Sample& old : samples) {
+                if (old.time > since) break;
+                base = &old;
+            }
+            if (!base && started < since && !samples.empty()) base = &samples.front();
+            uint64_t baseGames = 0, baseWins = 0;
+            if (base && i < base->seats.size()) {
+                baseGames = base->seats[i].first;
+                baseWins = base->seats[i].second;
+            }
+            publish(i, std::to_string(seconds) + "s", sample.seats[i].first - baseGames,
+                    sample.seats[i].second - baseWins);
+        }
+    }
+
+    uint64_t resident, peak;
+    readMemory(resident, peak);
+    registry.gauge("sevens_resident_bytes", "Resident set size").set(static_cast<double>(resident));
+    registry.gauge("sevens_peak_resident_bytes", "Peak resident set size").set(static_cast<double>(peak));
+
+    // Keep just enough history for the longest window
+    samples.push_back(std::move(sample));
+    uint64_t longest = 0;
+    for (uint64_t seconds : windows) longest = std::max(longest, seconds);
+    while (samples.size() > 1 && samples[1].time <= now - std::chrono::seconds(longest)) samples.pop_front();
+}
+
+} // namespace sevens
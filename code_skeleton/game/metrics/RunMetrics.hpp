@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Metrics.hpp"
+#include "../../strat/PlayerStrategy.hpp"
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * The metrics every simulation, training or tournament run exports:
+ *   sevens_games_total, sevens_games_per_second, sevens_uptime_seconds
+ *   sevens_seat_games_total / sevens_wins_total / sevens_rank_sum_total {strategy}
+ *   sevens_win_rate {strategy, window} with a Wilson 95% interval in
+ *     sevens_win_rate_lower / sevens_win_rate_upper; window is "total" or
+ *     one of the rolling windows, e.g. "60s"
+ *   sevens_decision_seconds {strategy} (histogram, via TimedStrategy)
+ *   sevens_resident_bytes / sevens_peak_resident_bytes
+ *
+ * Recording touches only sharded counters. The rates and windows are
+ * derived when the registry is rendered. Each scrape keeps a sample of
+ * the counters, and a window's rate compares now against the sample
+ * taken one window ago. The exporter's period therefore also sets how
+ * fine the windows are.
+ */
+class RunMetrics {
+public:
+    struct StrategyMetrics {
+        Counter& games;
+        Counter& wins;
+        Counter& rankSum;
+        LatencyHistogram& decisions;
+
+        // One seat's finish in one game
+        void record(uint64_t rank) {
+            games.add();
+            rankSum.add(rank);
+            if (rank == 1) wins.add();
+        }
+    };
+
+    explicit RunMetrics(MetricsRegistry& registry, std::vector<uint64_t> windowSeconds = {60, 600});
+
+    // Handles for a strategy name (created on first use; keep the reference)
+    StrategyMetrics& strategy(const std::string& name);
+
+    void gameFinished() { games.add(); }
+
+    // Wilson score interval for `wins` out of `n` at ~95% confidence
+    static void wilson(uint64_t wins, uint64_t n, double& lower, double& upper);
+
+private:
+    struct Sample {
+        std::chrono::steady_clock::time_point time;
+        uint64_t games;
+        std::vector<std::pair<uint64_t, uint64_t>> seats;  // (games, wins) per strategy, by index
+    };
+
+    MetricsRegistry& registry;
+    std::vector<uint64_t> windows;
+    Counter& games;
+    const std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<StrategyMetrics>> strategies;
+    std::deque<Sample> samples;
+
+    void collect();
+};
+
+/**
+ * Forwards to a strategy and times every decision into a histogram.
+ * A batch call counts each of its decisions at the batch's average time.
+ */
+class TimedStrategy : public PlayerStrategy {
+public:
+    TimedStrategy(std::shared_ptr<PlayerStrategy> inner, LatencyHistogram& histogram)
+        : inner(std::move(inner)), histogram(histogram) {}
+
+    void initialize(uint64_t playerID) override { inner->initialize(playerID); }
+    void onGameStart(const GameStartInfo& info) override { inner->onGameStart(info); }
+    void onGameEnd(uint64_t finalRank) override { inner->onGameEnd(finalRank); }
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const int index = inner->selectCardToPlay(hand, tableLayout);
+        histogram.observe(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+        return index;
+    }
+    void selectCardsBatch(const std::vector<BatchDecision>& positions, std::vector<int>& choices) override {
+        const auto start = std::chrono::steady_clock::now();
+        inner->selectCardsBatch(positions, choices);
+        if (positions.empty()) return;
+        const uint64_t each = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()) / positions.size();
+        for (size_t i = 0; i < positions.size(); i++) histogram.observe(each);
+    }
+    void observeMove(uint64_t playerID, const Card& playedCard) override { inner->observeMove(playerID, playedCard); }
+    void observePass(uint64_t playerID) override { inner->observePass(playerID); }
+    bool wantsObservations() const override { return inner->wantsObservations(); }
+    std::string getName() const override { return inner->getName(); }
+
+private:
+    std::shared_ptr<PlayerStrategy> inner;
+    LatencyHistogram& histogram;
+};
+
+} // namespace sevens
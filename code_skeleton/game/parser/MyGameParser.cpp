@@ -1,5 +1,9 @@
 #include "MyGameParser.hpp"
+#include "../../card/MyCardParser.hpp"
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 namespace sevens {
 
@@ -25,6 +29,39 @@ void MyGameParser::read_cards(const std::string& filename) {
 }
 
 void MyGameParser::read_game(const std::string& filename) {
+    this->rules = GameRules();
+
+    if (!filename.empty()) {
+        std::ifstream file(filename);
+        if (!file) {
+            throw std::runtime_error("Could not open game file: " + filename);
+        }
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            line = line.substr(0, line.find('#'));
+
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) {
+                if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                    throw std::runtime_error(filename + ":" + std::to_string(lineNumber) +
+                                             ": expected key = value");
+                }
+                continue;
+            }
+
+            auto trim = [](const std::string& text) {
+                size_t first = text.find_first_not_of(" \t\r");
+                size_t last = text.find_last_not_of(" \t\r");
+                return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+            };
+            parse_rule(trim(line.substr(0, eq)), trim(line.substr(eq + 1)), lineNumber);
+        }
+        this->rules.validate(GameRules::kMinPlayers);
+    }
+
     this->table_layout.clear();
 
     // Initialize table for all suits
@@ -37,12 +74,84 @@ void MyGameParser::read_game(const std::string& filename) {
         for (int rank = 1; rank <= 13; ++rank) {
             this->table_layout[suit][rank] = false;
         }
-        
-        // In Sevens, game starts with only 7s on the table
-        this->table_layout[suit][7] = true;
+    }
+
+    // Lay out the starting cards (the 7s unless the rules say otherwise)
+    for (const Card& card : this->rules.startCards) {
+        this->table_layout[card.suit][card.rank] = true;
     }
     
-    std::cout << "[MyGameParser::read_game] Table initialized with 7s of each suit.\n";
+    std::cout << "[MyGameParser::read_game] Table initialized with "
+              << this->rules.startCards.size() << " starting card(s)"
+              << (filename.empty() ? "" : " from " + filename) << ".\n";
+}
+
+void MyGameParser::parse_rule(const std::string& key, const std::string& value, int lineNumber) {
+    auto fail = [&](const std::string& why) {
+        throw std::runtime_error("Rules line " + std::to_string(lineNumber) + " (" + key + "): " + why);
+    };
+    auto toBool = [&](const std::string& text) {
+        if (text == "true" || text == "yes" || text == "1") return true;
+        if (text == "false" || text == "no" || text == "0") return false;
+        fail("expected true or false");
+        return false;
+    };
+    auto toInt = [&](const std::string& text) -> long long {
+        try {
+            size_t used = 0;
+            long long number = std::stoll(text, &used);
+            if (used != text.size()) fail("expected a number");
+            return number;
+        } catch (const std::logic_error&) {
+            fail("expected a number");
+        }
+        return 0;
+    };
+
+    try {
+        if (key == "decks") {
+            this->rules.numDecks = static_cast<uint64_t>(toInt(value));
+        } else if (key == "start_cards") {
+            this->rules.startCards.clear();
+            if (value != "none") {
+                std::istringstream tokens(value);
+                std::string token;
+                while (tokens >> token) {
+                    this->rules.startCards.push_back(MyCardParser::parse_card(token));
+                }
+            }
+        } else if (key == "open_rank") {
+            this->rules.openRank = static_cast<int>(toInt(value));
+        } else if (key == "ace") {
+            if (value == "low") this->rules.aceMode = AceMode::Low;
+            else if (value == "high") this->rules.aceMode = AceMode::High;
+            else if (value == "wrap") this->rules.aceMode = AceMode::Wrap;
+            else fail("expected low, high or wrap");
+        } else if (key == "first_card") {
+            this->rules.hasFirstCard = (value != "none");
+            if (this->rules.hasFirstCard) {
+                this->rules.firstCard = MyCardParser::parse_card(value);
+            }
+        } else if (key == "pass_penalty") {
+            this->rules.passPenalty = toInt(value);
+        } else if (key == "card_penalty") {
+            this->rules.cardPenalty = toInt(value);
+        } else if (key == "uneven_deal") {
+            if (value == "front") this->rules.unevenDeal = UnevenDeal::FrontSeats;
+            else if (value == "back") this->rules.unevenDeal = UnevenDeal::BackSeats;
+            else fail("expected front or back");
+        } else if (key == "tie_break") {
+            if (value == "seat") this->rules.tieBreak = TieBreak::SeatOrder;
+            else if (value == "shared") this->rules.tieBreak = TieBreak::SharedRank;
+            else fail("expected seat or shared");
+        } else if (key == "play_until_all_finish") {
+            this->rules.playUntilAllFinish = toBool(value);
+        } else {
+            fail("unknown setting");
+        }
+    } catch (const std::invalid_argument& e) {
+        fail(e.what());
+    }
 }
 
-} // namespace sevens
\ No newline at end of file
+} // namespace sevens
@@ -1,12 +1,26 @@
 #pragma once
 
 #include "Generic_game_parser.hpp"
+#include "../rules/GameRules.hpp"
 
 namespace sevens {
 
 /**
  * Derived from Generic_game_parser.
- * Subclasses must fill in read_game(...) to initialize the table layout.
+ * read_game(filename) loads a rules file (empty filename = standard Sevens)
+ * and lays out its starting cards in table_layout.
+ *
+ * Rules files are "key = value" lines, '#' starts a comment:
+ *   decks = 1                    # 52-card decks shuffled together
+ *   start_cards = 7C 7D 7H 7S    # on the table before play, or "none"
+ *   open_rank = 7                # rank that opens an empty suit
+ *   ace = low                    # low | high | wrap
+ *   first_card = 7D              # holder leads and must play it, or "none"
+ *   pass_penalty = 1             # chips paid into the pot per pass
+ *   card_penalty = 0             # chips per card left at the end, to the winner
+ *   uneven_deal = front          # front | back
+ *   tie_break = seat             # seat | shared
+ *   play_until_all_finish = true # false: stop at the first player out
  */
 class MyGameParser : public Generic_game_parser {
 public:
@@ -15,6 +29,15 @@ public:
 
     void read_cards(const std::string& filename) override;
     void read_game(const std::string& filename) override;
+
+    const GameRules& get_rules() const {
+        return this->rules;
+    }
+
+private:
+    GameRules rules;
+
+    void parse_rule(const std::string& key, const std::string& value, int lineNumber);
 };
 
 } // namespace sevens
@@ -0,0 +1,336 @@
+#include "ResultsFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sevens {
+
+namespace {
+
+constexpr size_t kHeaderSize = 12;       // magic[4] version:u16 players:u8 reserved:u8 strategies:u16 reserved:u16
+constexpr size_t kBlockHeaderSize = 8;   // rows:u32 payload:u32
+constexpr int kGameColumns = 3;          // Seed, Turns, Rounds
+constexpr int kColumnKinds = 9;
+
+uint64_t readLE(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+void appendLE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+// Bytes one game occupies in a block
+uint64_t rowWidth(uint64_t numPlayers) {
+    uint64_t width = 0;
+    for (int kind = 0; kind < kColumnKinds; kind++) {
+        width += ResultsFile::kWidths[kind] * (kind < kGameColumns ? 1 : numPlayers);
+    }
+    return width;
+}
+
+} // namespace
+
+ResultsFile::ResultsFile(const std::string& path) : file_path(path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open results file: " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not stat results file: " + path);
+    }
+    const size_t fileSize = static_cast<size_t>(info.st_size);
+    if (fileSize < kHeaderSize) {
+        ::close(fd);
+        throw std::runtime_error("Truncated results file header: " + path);
+    }
+
+    mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Could not map results file: " + path);
+    }
+    mapping_size = fileSize;
+    ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+
+    try {
+        index(static_cast<const uint8_t*>(mapping), fileSize);
+    } catch (...) {
+        ::munmap(mapping, mapping_size);
+        throw;
+    }
+}
+
+ResultsFile::~ResultsFile() {
+    if (mapping) {
+        ::munmap(mapping, mapping_size);
+    }
+}
+
+void ResultsFile::index(const uint8_t* bytes, size_t fileSize) {
+    if (std::memcmp(bytes, kMagic, 4) != 0) {
+        throw std::runtime_error("Not a results file: " + file_path);
+    }
+    if (readLE(bytes + 4, 2) != kVersion) {
+        throw std::runtime_error("Unsupported results file version: " + file_path);
+    }
+    num_players = bytes[6];
+    const uint64_t strategyCount = readLE(bytes + 8, 2);
+    if (num_players == 0) {
+        throw std::runtime_error("Corrupt results file: " + file_path);
+    }
+
+    size_t offset = kHeaderSize;
+    for (uint64_t i = 0; i < strategyCount; i++) {
+        if (offset + 2 > fileSize || offset + 2 + readLE(bytes + offset, 2) > fileSize) {
+            throw std::runtime_error("Truncated results file header: " + file_path);
+        }
+        const size_t length = readLE(bytes + offset, 2);
+        strategy_names.emplace_back(reinterpret_cast<const char*>(bytes + offset + 2), length);
+        offset += 2 + length;
+    }
+
+    // Walk the blocks; only the last one may be incomplete
+    const uint64_t width = rowWidth(num_players);
+    while (offset < fileSize) {
+        if (offset + kBlockHeaderSize > fileSize) {
+            has_torn_block = true;
+            break;
+        }
+        const uint64_t rows = readLE(bytes + offset, 4);
+        const uint64_t payload = readLE(bytes + offset + 4, 4);
+        if (payload != rows * width) {
+            throw std::runtime_error("Corrupt block at byte " + std::to_string(offset) + " of " + file_path);
+        }
+        if (offset + kBlockHeaderSize + payload > fileSize) {
+            has_torn_block = true;
+            break;
+        }
+        blocks.push_back(Block{game_count, rows, bytes + offset + kBlockHeaderSize});
+        game_count += rows;
+        offset += kBlockHeaderSize + payload;
+    }
+}
+
+ResultsFile::ColumnView ResultsFile::column(size_t block, ResultColumn column, uint64_t seat) const {
+    const Block& info = blocks.at(block);
+    const int kind = static_cast<int>(column);
+
+    // Columns before this one, each rows * width bytes
+    uint64_t offset = 0;
+    for (int k = 0; k < kind; k++) {
+        offset += kWidths[k] * (k < kGameColumns ? 1 : num_players);
+    }
+    if (perSeat(column)) {
+        if (seat >= num_players) {
+            throw std::out_of_range("No seat " + std::to_string(seat) + " in " + file_path);
+        }
+        offset += kWidths[kind] * seat;
+    }
+    return ColumnView(info.payload + offset * info.rows, kWidths[kind], info.rows);
+}
+
+void ResultsFile::get(uint64_t index, GameRecord& out) const {
+    if (index >= game_count) {
+        throw std::out_of_range("Game index out of range");
+    }
+    // Blocks are in game order; all but the last are usually full
+    size_t low = 0, high = blocks.size();
+    while (high - low > 1) {
+        const size_t middle = (low + high) / 2;
+        if (blocks[middle].firstGame <= index) low = middle;
+        else high = middle;
+    }
+    const uint64_t row = index - blocks[low].firstGame;
+
+    out.seed = column(low, ResultColumn::Seed)[row];
+    out.turns = column(low, ResultColumn::Turns)[row];
+    out.rounds = column(low, ResultColumn::Rounds)[row];
+    out.seats.resize(num_players);
+    for (uint64_t seat = 0; seat < num_players; seat++) {
+        SeatResult& result = out.seats[seat];
+        result.strategy = column(low, ResultColumn::Strategy, seat)[row];
+        result.rank = column(low, ResultColumn::Rank, seat)[row];
+        result.cardsLeft = column(low, ResultColumn::CardsLeft, seat)[row];
+        result.passes = column(low, ResultColumn::Passes, seat)[row];
+        result.decisions = column(low, ResultColumn::Decisions, seat)[row];
+        result.decisionNanos = column(low, ResultColumn::DecisionNanos, seat)[row];
+    }
+}
+
+ResultsWriter::ResultsWriter(const std::string& path, uint64_t numPlayers, std::vector<std::string> strategies,
+                             uint64_t rowsPerBlock, size_t maxPending)
+    : file_path(path),
+      file(path, std::ios::binary | std::ios::trunc),
+      num_players(numPlayers),
+      num_strategies(strategies.size()),
+      rows_per_block(std::max<uint64_t>(rowsPerBlock, 1)),
+      max_pending(std::max<size_t>(maxPending, 1))
+{
+    if (!file) {
+        throw std::runtime_error("Could not create results file: " + path);
+    }
+    if (numPlayers == 0 || numPlayers > 255 || strategies.size() > 0xFFFF) {
+        throw std::invalid_argument("Results files hold 1-255 seats and up to 65535 strategies");
+    }
+
+    std::vector<uint8_t> header;
+    header.insert(header.end(), ResultsFile::kMagic, ResultsFile::kMagic + 4);
+    appendLE(header, ResultsFile::kVersion, 2);
+    appendLE(header, numPlayers, 1);
+    appendLE(header, 0, 1);
+    appendLE(header, strategies.size(), 2);
+    appendLE(header, 0, 2);
+    for (const std::string& name : strategies) {
+        const size_t length = std::min<size_t>(name.size(), 0xFFFF);
+        appendLE(header, length, 2);
+        header.insert(header.end(), name.begin(), name.begin() + length);
+    }
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    columns.resize(kGameColumns + (kColumnKinds - kGameColumns) * num_players);
+    for (size_t i = 0; i < columns.size(); i++) {
+        const int kind = i < kGameColumns ? static_cast<int>(i)
+                                          : kGameColumns + static_cast<int>((i - kGameColumns) / num_players);
+        columns[i].reserve(rows_per_block * ResultsFile::kWidths[kind]);
+    }
+    worker = std::thread(&ResultsWriter::run, this);
+}
+
+ResultsWriter::~ResultsWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << "[ResultsWriter] " << e.what() << std::endl;
+    }
+}
+
+void ResultsWriter::append(const GameRecord& game) {
+    if (closed) {
+        throw std::logic_error("ResultsWriter::append after close");
+    }
+    if (game.seats.size() != num_players) {
+        throw std::invalid_argument("Game record has " + std::to_string(game.seats.size()) + " seats, expected " +
+                                    std::to_string(num_players));
+    }
+
+    // Check the whole record first, so a rejected one leaves no partial row
+    auto checkWidth = [](uint64_t value, int bytes, const char* column) {
+        if (bytes < 8 && value >> (8 * bytes) != 0) {
+            throw std::out_of_range(std::string(column) + " value " + std::to_string(value) + " does not fit in " +
+                                    std::to_string(bytes) + " byte(s)");
+        }
+    };
+    checkWidth(game.turns, 4, "Turns");
+    checkWidth(game.rounds, 4, "Rounds");
+    for (const SeatResult& result : game.seats) {
+        if (result.strategy >= num_strategies) {
+            throw std::out_of_range("Unknown strategy index " + std::to_string(result.strategy));
+        }
+        checkWidth(result.rank, 1, "Rank");
+        checkWidth(result.cardsLeft, 1, "CardsLeft");
+        checkWidth(result.passes, 2, "Passes");
+        checkWidth(result.decisions, 2, "Decisions");
+    }
+
+    appendLE(columns[0], game.seed, 8);
+    appendLE(columns[1], game.turns, 4);
+    appendLE(columns[2], game.rounds, 4);
+    const size_t n = num_players;
+    for (size_t seat = 0; seat < n; seat++) {
+        const SeatResult& result = game.seats[seat];
+        appendLE(columns[kGameColumns + 0 * n + seat], result.strategy, 2);
+        appendLE(columns[kGameColumns + 1 * n + seat], result.rank, 1);
+        appendLE(columns[kGameColumns + 2 * n + seat], result.cardsLeft, 1);
+        appendLE(columns[kGameColumns + 3 * n + seat], result.passes, 2);
+        appendLE(columns[kGameColumns + 4 * n + seat], result.decisions, 2);
+        appendLE(columns[kGameColumns + 5 * n + seat], result.decisionNanos, 8);
+    }
+    game_count++;
+    if (++rows == rows_per_block) seal();
+}
+
+void ResultsWriter::seal() {
+    if (rows == 0) return;
+
+    std::vector<uint8_t> block;
+    block.reserve(kBlockHeaderSize + rows * rowWidth(num_players));
+    appendLE(block, rows, 4);
+    appendLE(block, rows * rowWidth(num_players), 4);
+    for (auto& column : columns) {
+        block.insert(block.end(), column.begin(), column.end());
+        column.clear();
+    }
+    rows = 0;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        space.wait(lock, [this]() { return queue.size() < max_pending || error; });
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+        queue.push_back(std::move(block));
+    }
+    wake.notify_one();
+}
+
+void ResultsWriter::close() {
+    if (closed) return;
+    closed = true;
+
+    std::exception_ptr failure;
+    try {
+        seal();
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+
+    file.flush();
+    if (!failure && error) failure = std::exchange(error, nullptr);
+    if (!failure && !file) {
+        failure = std::make_exception_ptr(std::runtime_error("Could not write results file: " + file_path));
+    }
+    file.close();
+    if (failure) std::rethrow_exception(failure);
+}
+
+void ResultsWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return !queue.empty() || stopping; });
+        if (queue.empty()) return;
+
+        std::vector<uint8_t> block = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        space.notify_one();
+
+        file.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+        const bool failed = !file;
+
+        lock.lock();
+        if (failed && !error) {
+            error = std::make_exception_ptr(std::runtime_error("Could not write results file: " + file_path));
+        }
+    }
+}
+
+} // namespace sevens
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * One seat's outcome in one game. `strategy` indexes the file's strategy
+ * names.
+ */
+struct SeatResult {
+    uint64_t strategy = 0;
+    uint64_t rank = 0;
+    uint64_t cardsLeft = 0;
+    uint64_t passes = 0;
+    uint64_t decisions = 0;
+    uint64_t decisionNanos = 0;
+};
+
+/**
+ * One game as stored in a results file.
+ */
+struct GameRecord {
+    uint64_t seed = 0;
+    uint64_t turns = 0;
+    uint64_t rounds = 0;
+    std::vector<SeatResult> seats;
+};
+
+/**
+ * Columns of a results file. Seed, Turns and Rounds have one value per
+ * game; the others have one value per game and seat.
+ */
+enum class ResultColumn : uint8_t {
+    Seed,           // u64
+    Turns,          // u32
+    Rounds,         // u32
+    Strategy,       // u16
+    Rank,           // u8
+    CardsLeft,      // u8
+    Passes,         // u16
+    Decisions,      // u16
+    DecisionNanos   // u64
+};
+
+/**
+ * Column-oriented store of simulated games, for scanning hundreds of
+ * millions of results without re-simulating them.
+ *
+ * File layout (little-endian): magic "SVRS", version:u16, players:u8,
+ * reserved:u8, strategies:u16, then each strategy name as length:u16 and
+ * bytes. Blocks follow, each holding up to a few thousand games:
+ * rows:u32, payload size:u32, then every column of the block stored
+ * contiguously: Seed, Turns, Rounds, then for each per-seat column (in
+ * ResultColumn order) the values of seat 0, seat 1, ... A scan therefore
+ * touches only the pages of the columns it reads.
+ *
+ * The file is memory-mapped. A block cut short by a crash is ignored (see
+ * truncated()); any other damage throws std::runtime_error.
+ */
+class ResultsFile {
+public:
+    static constexpr char kMagic[4] = {'S', 'V', 'R', 'S'};
+    static constexpr uint16_t kVersion = 1;
+
+    // Bytes per value of each column
+    static constexpr uint8_t kWidths[] = {8, 4, 4, 2, 1, 1, 2, 2, 8};
+
+    static bool perSeat(ResultColumn column) { return column >= ResultColumn::Strategy; }
+
+    // Values of one column within one block
+    class ColumnView {
+    public:
+        ColumnView(const uint8_t* data, uint8_t width, uint64_t rows) : data(data), width(width), rows(rows) {}
+
+        uint64_t size() const { return rows; }
+        uint64_t operator[](uint64_t row) const {
+            const uint8_t* value = data + row * width;
+            uint64_t result = 0;
+            for (uint8_t i = 0; i < width; i++) result |= static_cast<uint64_t>(value[i]) << (8 * i);
+            return result;
+        }
+
+    private:
+        const uint8_t* data;
+        uint8_t width;
+        uint64_t rows;
+    };
+
+    explicit ResultsFile(const std::string& path);
+    ~ResultsFile();
+
+    ResultsFile(const ResultsFile&) = delete;
+    ResultsFile& operator=(const ResultsFile&) = delete;
+
+    uint64_t numPlayers() const { return num_players; }
+    const std::vector<std::string>& strategies() const { return strategy_names; }
+    uint64_t size() const { return game_count; }
+    bool truncated() const { return has_torn_block; }
+
+    size_t blockCount() const { return blocks.size(); }
+    uint64_t blockRows(size_t block) const { return blocks[block].rows; }
+    // seat is ignored for per-game columns
+    ColumnView column(size_t block, ResultColumn column, uint64_t seat = 0) const;
+
+    // Decode game `index` (counting across blocks) into out
+    void get(uint64_t index, GameRecord& out) const;
+
+private:
+    struct Block {
+        uint64_t firstGame;
+        uint64_t rows;
+        const uint8_t* payload;
+    };
+
+    std::string file_path;
+    uint64_t num_players = 0;
+    std::vector<std::string> strategy_names;
+    uint64_t game_count = 0;
+    bool has_torn_block = false;
+    std::vector<Block> blocks;
+
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+
+    void index(const uint8_t* bytes, size_t fileSize);
+};
+
+/**
+ * Buffers games into column blocks and writes them from a background
+ * thread, so the simulation only pays for copying a few bytes per game.
+ *
+ * append() fills the current block; a full block is handed to the writer
+ * thread, and append() waits only if `maxPending` blocks are already
+ * queued. A write error is rethrown by the next append() or close().
+ */
+class ResultsWriter {
+public:
+    ResultsWriter(const std::string& path, uint64_t numPlayers, std::vector<std::string> strategies,
+                  uint64_t rowsPerBlock = 4096, size_t maxPending = 8);
+    ~ResultsWriter();
+
+    ResultsWriter(const ResultsWriter&) = delete;
+    ResultsWriter& operator=(const ResultsWriter&) = delete;
+
+    // game.seats must have numPlayers entries, and every value must fit its
+    // column (std::out_of_range otherwise; nothing is written then)
+    void append(const GameRecord& game);
+
+    // Writes the partial block, waits for the writer and closes the file;
+    // called by the destructor
+    void close();
+
+    uint64_t written() const { return game_count; }
+
+private:
+    std::string file_path;
+    std::ofstream file;
+    uint64_t num_players;
+    uint64_t num_strategies;
+    uint64_t rows_per_block;
+    size_t max_pending;
+    uint64_t game_count = 0;
+    bool closed = false;
+
+    // Current block: one buffer per (column, seat)
+    std::vector<std::vector<uint8_t>> columns;
+    uint64_t rows = 0;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable space;
+    std::deque<std::vector<uint8_t>> queue;
+    bool stopping = false;
+    std::exception_ptr error;
+    std::thread worker;
+
+    void seal();
+    void run();
+};
+
+} // namespace sevens
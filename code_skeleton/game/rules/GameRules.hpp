@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../../card/Generic_card_parser.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Who receives the extra cards when the deck does not split evenly.
+ *   FrontSeats: seats 0,1,... get one extra card each (first to act)
+ *   BackSeats:  the last seats get one extra card each (dealer's left gets fewer)
+ */
+enum class UnevenDeal {
+    FrontSeats,
+    BackSeats
+};
+
+/**
+ * How players who did not finish are ordered when they hold as many cards.
+ *   SeatOrder:  lower seat ranks first, every rank is distinct
+ *   SharedRank: tied players share a rank and the next rank is skipped (1,2,2,4)
+ */
+enum class TieBreak {
+    SeatOrder,
+    SharedRank
+};
+
+/**
+ * Where the ace sits in a suit row.
+ *   Low:  below the 2 (A-2-...-K), the classic layout
+ *   High: above the King (2-...-K-A)
+ *   Wrap: at either end; it can follow the 2 or the King
+ */
+enum class AceMode {
+    Low,
+    High,
+    Wrap
+};
+
+/**
+ * Table-level rules for a Sevens game.
+ * The defaults reproduce a single 52-card deck with the 7s laid out.
+ * House variants are loaded from a rules file by MyGameParser::read_game.
+ */
+struct GameRules {
+    static constexpr uint64_t kMinPlayers = 2;
+    static constexpr uint64_t kMaxPlayers = 8;
+    static constexpr uint64_t kMaxDecks = 4;
+
+    uint64_t numDecks = 1;
+    UnevenDeal unevenDeal = UnevenDeal::FrontSeats;
+    TieBreak tieBreak = TieBreak::SeatOrder;
+
+    // true: keep playing until every seat is placed; false: stop at the first winner
+    bool playUntilAllFinish = true;
+
+    // Layout: the rank that opens an empty suit row (7 in Sevens) and the
+    // cards already on the table before anyone plays (one entry per copy)
+    int openRank = 7;
+    AceMode aceMode = AceMode::Low;
+    std::vector<Card> startCards = {Card{0, 7}, Card{1, 7}, Card{2, 7}, Card{3, 7}};
+
+    // Optional opening card: its holder leads and must play it first (e.g. 7D)
+    bool hasFirstCard = false;
+    Card firstCard{1, 7};
+
+    // Chip payments: each pass pays passPenalty into the pot, and at the end
+    // every unplaced player pays cardPenalty per card left; the winner takes the pot
+    int64_t passPenalty = 0;
+    int64_t cardPenalty = 0;
+
+    // Throws std::invalid_argument if the rules cannot host numPlayers
+    void validate(uint64_t numPlayers) const {
+        if (numPlayers < kMinPlayers || numPlayers > kMaxPlayers) {
+            throw std::invalid_argument("Sevens supports " + std::to_string(kMinPlayers) +
+                                        " to " + std::to_string(kMaxPlayers) +
+                                        " players, got " + std::to_string(numPlayers));
+        }
+        if (numDecks < 1 || numDecks > kMaxDecks) {
+            throw std::invalid_argument("Unsupported number of decks: " + std::to_string(numDecks));
+        }
+        if (openRank < 1 || openRank > 13) {
+            throw std::invalid_argument("Opening rank must be 1..13");
+        }
+        if (aceMode == AceMode::Wrap && openRank == 1) {
+            throw std::invalid_argument("The ace cannot open a row when it wraps");
+        }
+        if (passPenalty < 0 || cardPenalty < 0) {
+            throw std::invalid_argument("Chip penalties cannot be negative");
+        }
+        for (const Card& card : startCards) {
+            uint64_t copies = 0;
+            for (const Card& other : startCards) {
+                if (other.suit == card.suit && other.rank == card.rank) copies++;
+            }
+            if (card.suit < 0 || card.suit > 3 || card.rank < 1 || card.rank > 13 || copies > numDecks) {
+                throw std::invalid_argument("Invalid starting card layout");
+            }
+            // Its holder is meant to lead with it, but it would start on the table
+            if (hasFirstCard && card.suit == firstCard.suit && card.rank == firstCard.rank) {
+                throw std::invalid_argument("The opening card cannot also be a starting card");
+            }
+        }
+    }
+};
+
+} // namespace sevens
@@ -0,0 +1,95 @@
+#include "GameState.hpp"
+#include "MoveGenerator.hpp"
+#include <stdexcept>
+
+namespace sevens {
+
+StateRules StateRules::compile(const GameRules& rules) {
+    StateRules compiled;
+    compiled.play_until_all_finish = rules.playUntilAllFinish;
+    if (rules.hasFirstCard) compiled.first_card = PackedCard(rules.firstCard).id;
+    for (const Card& card : rules.startCards) compiled.start_table |= PackedCard(card).bit();
+
+    // Same unlock tables as the engine's move generator, sorted by the shift that reaches them
+    const MoveGenerator gen = MoveGenerator::compile(rules);
+    for (int rank = 1; rank <= 13; rank++) {
+        uint64_t suits = 0;
+        for (int suit = 0; suit < 4; suit++) suits |= PackedCard(suit, rank).bit();
+        if (gen.unlockRank(rank, 0) == 0) {
+            compiled.opens |= suits;
+            continue;
+        }
+        for (int which = 0; which < 2; which++) {
+            const int inner = gen.unlockRank(rank, which);
+            if (inner == 0) continue;
+            if (inner == rank + 1) compiled.from_above |= suits;
+            else if (inner == rank - 1) compiled.from_below |= suits;
+            else if (rank == 1 && inner == 13) compiled.from_king |= suits;
+            else if (rank == 13 && inner == 1) compiled.from_ace |= suits;
+            else throw std::logic_error("Unlock rank " + std::to_string(inner) + " is not next to " +
+                                        std::to_string(rank));
+        }
+    }
+    return compiled;
+}
+
+void GameState::deal(const StateRules& rules, const std::vector<std::vector<Card>>& dealt) {
+    if (dealt.size() < GameRules::kMinPlayers || dealt.size() > kMaxPlayers) {
+        throw std::invalid_argument("Cannot deal to " + std::to_string(dealt.size()) + " seats");
+    }
+    hands.fill(0);
+    cards_left.fill(0);
+
+    // The holder of the opening card (if the rules have one) leads the game
+    uint8_t leadSeat = 0;
+    bool pending = false;
+    for (uint8_t seat = 0; seat < dealt.size(); seat++) {
+        for (const Card& card : dealt[seat]) {
+            const PackedCard packed(card);
+            hands[seat] |= packed.bit();
+            if (packed.id == rules.first_card && !pending) {
+                leadSeat = seat;
+                pending = true;
+            }
+        }
+        cards_left[seat] = static_cast<uint8_t>(dealt[seat].size());
+    }
+    begin(rules, static_cast<uint8_t>(dealt.size()), leadSeat, pending);
+}
+
+void GameState::begin(const StateRules& rules, uint8_t numPlayers, uint8_t leadSeat, bool firstCardPending) {
+    num_players = numPlayers;
+    lead = leadSeat;
+    finish_order.fill(0);
+    table = rules.start_table;
+    first_card = rules.first_card;
+    play_until_all_finish = rules.play_until_all_finish;
+
+    // The first advance() opens round one
+    cursor = Cursor{};
+    cursor.turn = num_players;
+    cursor.flags = static_cast<uint8_t>(kRoundHadMove | (firstCardPending ? kFirstCardPending : 0));
+    advance();
+}
+
+std::array<uint8_t, GameState::kMaxPlayers> GameState::ranks(TieBreak tieBreak) const {
+    std::array<uint8_t, kMaxPlayers> result{};
+    for (uint8_t i = 0; i < cursor.finished; i++) result[finish_order[i]] = static_cast<uint8_t>(i + 1);
+
+    // Everybody else by cards left, then seat order (or sharing the rank)
+    for (uint8_t seat = 0; seat < num_players; seat++) {
+        if (cards_left[seat] == 0) continue;
+        uint8_t rank = static_cast<uint8_t>(cursor.finished + 1);
+        for (uint8_t other = 0; other < num_players; other++) {
+            if (other == seat || cards_left[other] == 0) continue;
+            if (cards_left[other] < cards_left[seat] ||
+                (tieBreak == TieBreak::SeatOrder && cards_left[other] == cards_left[seat] && other < seat)) {
+                rank++;
+            }
+        }
+        result[seat] = rank;
+    }
+    return result;
+}
+
+} // namespace sevens
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "GameRules.hpp"
+#include "../../card/PackedCard.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * A ruleset's layout flattened to 52-bit card masks (bit = PackedCard id),
+ * shared by every GameState of a game or search.
+ *
+ * A card becomes playable when an inner neighbour is down. Within a suit
+ * the neighbours are one bit away, except for the ace at either end of an
+ * ace-high or wrapping row, so playable() is five shifts and masks.
+ */
+struct StateRules {
+    uint64_t opens = 0;       // Cards that open an empty row
+    uint64_t from_above = 0;  // Unlocked by the next rank up (bit + 1)
+    uint64_t from_below = 0;  // Unlocked by the rank below (bit - 1)
+    uint64_t from_king = 0;   // Aces unlocked by their King (bit + 12)
+    uint64_t from_ace = 0;    // Kings unlocked by their ace (bit - 12)
+    uint64_t start_table = 0;
+    uint8_t first_card = PackedCard::kNone;
+    bool play_until_all_finish = true;
+
+    static StateRules compile(const GameRules& rules);
+
+    // Cards not on the table that could be played onto it
+    uint64_t playable(uint64_t table) const {
+        return (opens | ((table >> 1) & from_above) | ((table << 1) & from_below) |
+                ((table >> 12) & from_king) | ((table << 12) & from_ace)) & ~table;
+    }
+};
+
+/**
+ * Complete state of a game in progress as one trivially copyable value:
+ * the hands and the table as 52-bit masks plus the turn cursor. Copying it
+ * is a 128-byte memcpy, and play()/pass() return an Undo record that
+ * restores the previous state exactly, so search can walk a tree with one
+ * state and a stack of Undo records and no heap traffic.
+ *
+ * The turn order is MyGameMapper's: rounds start from the lead seat (the
+ * holder of the opening card, if any), empty hands are skipped, a seat with
+ * no legal move passes, and the game can only end between rounds.
+ *
+ * The card masks hold one copy of each card. With more decks only the turn
+ * cursor, cards left and finish order are meaningful; MyGameMapper then
+ * checks moves with MoveGenerator.
+ */
+struct alignas(64) GameState {
+    static constexpr size_t kMaxPlayers = GameRules::kMaxPlayers;
+
+    // Position in the turn order; everything play() and pass() change except the cards
+    struct Cursor {
+        uint8_t seat = 0;      // Seat to move
+        uint8_t turn = 0;      // Turns of the current round taken or started
+        uint8_t finished = 0;  // Entries of finish_order in use
+        uint8_t flags = 0;
+        uint16_t rounds = 0;   // Rounds started
+    };
+
+    // Everything needed to take back one play() or pass()
+    struct Undo {
+        Cursor cursor;
+        uint8_t card = PackedCard::kNone;  // kNone for a pass
+    };
+
+    std::array<uint64_t, kMaxPlayers> hands{};
+    uint64_t table = 0;
+    std::array<uint8_t, kMaxPlayers> cards_left{};
+    std::array<uint8_t, kMaxPlayers> finish_order{};  // Seats in the order they went out
+    Cursor cursor;
+    uint8_t num_players = 0;
+    uint8_t lead = 0;
+    uint8_t first_card = PackedCard::kNone;
+    bool play_until_all_finish = true;
+
+    static constexpr uint8_t kRoundHadMove = 1;
+    static constexpr uint8_t kFirstCardPending = 2;
+    static constexpr uint8_t kOver = 4;
+
+    // Start a game: the layout of `rules` on the table, hands[i] in seat i,
+    // the first seat to act on move
+    void deal(const StateRules& rules, const std::vector<std::vector<Card>>& dealt);
+
+    // Start a game from hands and cards_left as already filled in, with
+    // `leadSeat` opening every round (owing the opening card if firstCardPending).
+    // Used when not every hand is known, e.g. a strategy's view of the table.
+    void begin(const StateRules& rules, uint8_t numPlayers, uint8_t leadSeat, bool firstCardPending);
+
+    bool over() const { return cursor.flags & kOver; }
+    uint8_t toMove() const { return cursor.seat; }
+    uint8_t finished() const { return cursor.finished; }
+    uint16_t rounds() const { return cursor.rounds; }
+    bool firstCardPending() const { return cursor.flags & kFirstCardPending; }
+
+    // Moves of the seat on move (only the opening card while it is pending); 0 means it must pass
+    uint64_t legalMoves(const StateRules& rules) const {
+        if (cursor.flags & kFirstCardPending) return PackedCard(first_card).bit();
+        return hands[cursor.seat] & rules.playable(table);
+    }
+
+    // The seat on move plays `card`, which must be one of legalMoves()
+    Undo play(PackedCard card) {
+        const Undo record{cursor, card.id};
+        const uint8_t seat = cursor.seat;
+        hands[seat] &= ~card.bit();
+        table |= card.bit();
+        if (--cards_left[seat] == 0) finish_order[cursor.finished++] = seat;
+        cursor.flags = static_cast<uint8_t>((cursor.flags | kRoundHadMove) & ~kFirstCardPending);
+        advance();
+        return record;
+    }
+
+    // The seat on move passes (legalMoves() was 0)
+    Undo pass() {
+        const Undo record{cursor, PackedCard::kNone};
+        advance();
+        return record;
+    }
+
+    void undo(const Undo& record) {
+        if (record.card != PackedCard::kNone) {
+            const uint64_t bit = PackedCard(record.card).bit();
+            hands[record.cursor.seat] |= bit;
+            table &= ~bit;
+            if (cards_left[record.cursor.seat]++ == 0) finish_order[record.cursor.finished] = 0;
+        }
+        cursor = record.cursor;
+    }
+
+    // Final rank of every seat (1 = winner) with the mapper's tie rules;
+    // meaningful once over()
+    std::array<uint8_t, kMaxPlayers> ranks(TieBreak tieBreak) const;
+
+private:
+    // Move the cursor to the next seat holding cards, opening a new round
+    // or ending the game when the current round is done
+    void advance() {
+        while (true) {
+            if (cursor.turn == num_players) {
+                if (roundEndsGame()) {
+                    cursor.flags |= kOver;
+                    return;
+                }
+                cursor.flags &= static_cast<uint8_t>(~kRoundHadMove);
+                cursor.turn = 0;
+                cursor.rounds++;
+            }
+            uint8_t seat = static_cast<uint8_t>(lead + cursor.turn++);
+            if (seat >= num_players) seat = static_cast<uint8_t>(seat - num_players);
+            if (cards_left[seat] != 0) {
+                cursor.seat = seat;
+                return;
+            }
+        }
+    }
+
+    bool roundEndsGame() const {
+        // Classic ending: stop as soon as somebody has no cards left
+        if (!play_until_all_finish) return cursor.finished > 0;
+        // Placement play: the last seat left is placed automatically, and a
+        // full round without a card played would repeat forever
+        return cursor.finished + 1 >= num_players || !(cursor.flags & kRoundHadMove);
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<GameState>);
+static_assert(sizeof(GameState) == 128, "GameState should stay within two cache lines");
+
+} // namespace sevens
@@ -0,0 +1,73 @@
+#include "MoveGenerator.hpp"
+
+namespace sevens {
+
+MoveGenerator::MoveGenerator() {
+    build(GameRules());
+}
+
+MoveGenerator::MoveGenerator(const GameRules& rules) {
+    build(rules);
+}
+
+template <bool kTwoSided>
+bool MoveGenerator::playableImpl(const MoveGenerator& gen, const Row& row, int rank) {
+    const uint8_t placed = row[rank];
+    if (placed >= gen.decks) return false;
+
+    const uint8_t first = gen.inner_first[rank];
+    if (first == 0) return true;
+    if (row[first] > placed) return true;
+
+    if (kTwoSided) {
+        const uint8_t second = gen.inner_second[rank];
+        return second != 0 && row[second] > placed;
+    }
+    return false;
+}
+
+template <bool kTwoSided>
+void MoveGenerator::collectImpl(const MoveGenerator& gen, const TableCounts& table,
+                                const std::vector<Card>& hand, std::vector<Card>& out) {
+    out.clear();
+    for (const Card& card : hand) {
+        if (playableImpl<kTwoSided>(gen, table[card.suit], card.rank)) {
+            out.push_back(card);
+        }
+    }
+}
+
+void MoveGenerator::build(const GameRules& rules) {
+    MoveGenerator& gen = *this;
+    gen.decks = static_cast<uint8_t>(rules.numDecks);
+
+    // Position of each rank along a row; ace-high moves the ace past the King
+    auto position = [&rules](int rank) {
+        return (rank == 1 && rules.aceMode == AceMode::High) ? 14 : rank;
+    };
+    auto rankAt = [](int pos) {
+        return pos == 14 ? 1 : pos;
+    };
+
+    const int open = position(rules.openRank);
+    for (int rank = 1; rank <= 13; rank++) {
+        const int pos = position(rank);
+        gen.inner_first[rank] = 0;
+        gen.inner_second[rank] = 0;
+        if (pos == open) continue;
+        gen.inner_first[rank] = static_cast<uint8_t>(rankAt(pos < open ? pos + 1 : pos - 1));
+    }
+
+    if (rules.aceMode == AceMode::Wrap) {
+        // The ace hangs off either end of the row
+        gen.inner_first[1] = 2;
+        gen.inner_second[1] = 13;
+        gen.playable_fn = &MoveGenerator::playableImpl<true>;
+        gen.collect_fn = &MoveGenerator::collectImpl<true>;
+    } else {
+        gen.playable_fn = &MoveGenerator::playableImpl<false>;
+        gen.collect_fn = &MoveGenerator::collectImpl<false>;
+    }
+}
+
+} // namespace sevens
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "GameRules.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace sevens {
+
+// Copies of each card on the table, [suit][rank] (rank 0 unused)
+using TableCounts = std::array<std::array<uint8_t, 14>, 4>;
+
+/**
+ * Move generator specialised for one ruleset.
+ *
+ * compile() turns the layout options (opening rank, ace placement, decks)
+ * into per-rank unlock tables and picks a template instance for the rules'
+ * shape, so the per-turn check is a couple of array lookups with no
+ * branching on options.
+ *
+ * A copy of a card is playable when fewer than numDecks copies are down and
+ * either its rank opens a row or an inner neighbour has more copies down.
+ */
+class MoveGenerator {
+public:
+    MoveGenerator();
+    explicit MoveGenerator(const GameRules& rules);
+
+    static MoveGenerator compile(const GameRules& rules) { return MoveGenerator(rules); }
+
+    bool isPlayable(const TableCounts& table, const Card& card) const {
+        return playable_fn(*this, table[card.suit], card.rank);
+    }
+
+    // Ranks whose card unlocks `rank` (0 = none); both 0 means the rank opens a row
+    uint8_t unlockRank(int rank, int which) const {
+        return which == 0 ? inner_first[rank] : inner_second[rank];
+    }
+
+    // Append every playable card of hand to out (out is cleared first)
+    void collect(const TableCounts& table, const std::vector<Card>& hand, std::vector<Card>& out) const {
+        collect_fn(*this, table, hand, out);
+    }
+
+private:
+    using Row = std::array<uint8_t, 14>;
+
+    uint8_t decks = 1;
+    // Inner neighbours that unlock each rank; 0 means the rank opens a row
+    std::array<uint8_t, 14> inner_first{};
+    std::array<uint8_t, 14> inner_second{};
+
+    bool (*playable_fn)(const MoveGenerator&, const Row&, int) = nullptr;
+    void (*collect_fn)(const MoveGenerator&, const TableCounts&,
+                       const std::vector<Card>&, std::vector<Card>&) = nullptr;
+
+    void build(const GameRules& rules);
+
+    template <bool kTwoSided>
+    static bool playableImpl(const MoveGenerator& gen, const Row& row, int rank);
+
+    template <bool kTwoSided>
+    static void collectImpl(const MoveGenerator& gen, const TableCounts& table,
+                            const std::vector<Card>& hand, std::vector<Card>& out);
+};
+
+} // namespace sevens
@@ -0,0 +1,44 @@
+#include "Arena.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace sevens {
+
+Arena::Arena(size_t blockBytes) : block_bytes(blockBytes) {
+    if (block_bytes == 0) {
+        throw std::invalid_argument("Arena blocks cannot be empty");
+    }
+}
+
+void* Arena::allocateSlow(size_t bytes, size_t align) {
+    // Move on to the next kept block that fits, or add one (oversized requests get their own)
+    const size_t needed = bytes + align - 1;
+    for (size_t next = (current < blocks.size()) ? current + 1 : 0; next < blocks.size(); next++) {
+        if (blocks[next].size >= needed) {
+            current = next;
+            used = 0;
+            return allocate(bytes, align);
+        }
+    }
+    Block block;
+    block.size = std::max(block_bytes, needed);
+    block.data.reset(new std::byte[block.size]);
+    blocks.push_back(std::move(block));
+    current = blocks.size() - 1;
+    used = 0;
+    return allocate(bytes, align);
+}
+
+size_t Arena::bytesUsed() const {
+    size_t total = used;
+    for (size_t i = 0; i < current && i < blocks.size(); i++) total += blocks[i].size;
+    return total;
+}
+
+size_t Arena::bytesReserved() const {
+    size_t total = 0;
+    for (const Block& block : blocks) total += block.size;
+    return total;
+}
+
+} // namespace sevens
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Bump allocator for search nodes and scratch arrays.
+ *
+ * Memory comes from large blocks that are kept for the arena's lifetime:
+ * allocating is a pointer bump, and reset() (between searches) or
+ * rewind(mark) (when a subtree is done) frees in O(1) without touching the
+ * heap, so a search that reuses its arena never calls malloc after warm-up.
+ * Only trivially destructible types may live here, since nothing is
+ * destroyed. One arena per thread.
+ */
+class Arena {
+public:
+    // Where the arena stood at mark(); rewind() frees everything allocated since
+    struct Mark {
+        size_t block = 0;
+        size_t used = 0;
+    };
+
+    explicit Arena(size_t blockBytes = size_t(1) << 20);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t align) {
+        if (current < blocks.size()) {
+            const Block& block = blocks[current];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            const size_t offset = ((base + used + align - 1) & ~(uintptr_t(align) - 1)) - base;
+            if (offset + bytes <= block.size) [[likely]] {
+                used = offset + bytes;
+                return block.data.get() + offset;
+            }
+        }
+        return allocateSlow(bytes, align);
+    }
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // count default-initialised elements (uninitialised for trivial types)
+    template <typename T>
+    T* makeArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+        return new (allocate(sizeof(T) * count, alignof(T))) T[count];
+    }
+
+    Mark mark() const { return Mark{current, used}; }
+    void rewind(const Mark& to) {
+        current = to.block;
+        used = to.used;
+    }
+    void reset() { rewind(Mark{}); }
+
+    // Bytes handed out since the last reset (including alignment padding)
+    size_t bytesUsed() const;
+    size_t bytesReserved() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks;
+    size_t block_bytes;
+    size_t current = 0;  // Block being filled
+    size_t used = 0;     // Bytes of it taken
+
+    void* allocateSlow(size_t bytes, size_t align);
+};
+
+} // namespace sevens
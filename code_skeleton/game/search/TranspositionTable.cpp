@@ -0,0 +1,123 @@
+#include "TranspositionTable.hpp"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace sevens {
+
+namespace {
+
+// data layout: value[0..31] move[32..39] depth[40..47] bound[48..49] valid[50] generation[56..63]
+constexpr uint64_t kValid = 1ULL << 50;
+
+} // namespace
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    const size_t count = megabytes * 1024 * 1024 / sizeof(Bucket);
+    if (count == 0) {
+        throw std::invalid_argument("Transposition table needs at least one bucket");
+    }
+    buckets.reset(new Bucket[count]);
+    bucket_count = count;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucket_count; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    current_generation.store(0, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::pack(const TTEntry& entry, uint8_t generation) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(entry.value)) |
+           static_cast<uint64_t>(entry.move) << 32 |
+           static_cast<uint64_t>(entry.depth) << 40 |
+           static_cast<uint64_t>(entry.bound) << 48 |
+           kValid |
+           static_cast<uint64_t>(generation) << 56;
+}
+
+TTEntry TranspositionTable::unpack(uint64_t data) {
+    TTEntry entry;
+    entry.value = static_cast<int32_t>(static_cast<uint32_t>(data));
+    entry.move = static_cast<uint8_t>(data >> 32);
+    entry.depth = static_cast<uint8_t>(data >> 40);
+    entry.bound = static_cast<TTBound>((data >> 48) & 3);
+    entry.generation = static_cast<uint8_t>(data >> 56);
+    return entry;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& out) const {
+    const Bucket& bucket = bucketFor(key);
+    for (const Slot& slot : bucket.slots) {
+        const uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((data & kValid) && (check ^ data) == key) {
+            out = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, const TTEntry& entry) {
+    const uint8_t generation = current_generation.load(std::memory_order_relaxed);
+    const uint64_t data = pack(entry, generation);
+    Bucket& bucket = bucketFor(key);
+
+    Slot* victim = nullptr;
+    int victim_score = INT_MAX;
+    for (Slot& slot : bucket.slots) {
+        const uint64_t old_data = slot.data.load(std::memory_order_relaxed);
+        const uint64_t old_check = slot.check.load(std::memory_order_relaxed);
+        if (!(old_data & kValid)) {
+            // Empty slot: nothing can be cheaper to evict
+            if (victim_score > INT_MIN) {
+                victim = &slot;
+                victim_score = INT_MIN;
+            }
+            continue;
+        }
+        const TTEntry old = unpack(old_data);
+        if ((old_check ^ old_data) == key) {
+            // Same position: keep a clearly deeper result from this search
+            if (old.generation == generation && old.depth > entry.depth + 2 && entry.bound != TTBound::Exact) {
+                return;
+            }
+            victim = &slot;
+            break;
+        }
+        const int age = static_cast<uint8_t>(generation - old.generation);
+        const int score = static_cast<int>(old.depth) - 8 * age;
+        if (score < victim_score) {
+            victim = &slot;
+            victim_score = score;
+        }
+    }
+
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+    victim->data.store(data, std::memory_order_relaxed);
+}
+
+unsigned TranspositionTable::hashfull() const {
+    const uint8_t generation = current_generation.load(std::memory_order_relaxed);
+    const size_t sample = std::min<size_t>(bucket_count, 1000);
+    size_t used = 0;
+    for (size_t i = 0; i < sample; i++) {
+        for (const Slot& slot : buckets[i].slots) {
+            const uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if ((data & kValid) && static_cast<uint8_t>(data >> 56) == generation) used++;
+        }
+    }
+    return static_cast<unsigned>(used * 1000 / (sample * kBucketSlots));
+}
+
+} // namespace sevens
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace sevens {
+
+// How a stored value relates to the true value of the position
+enum class TTBound : uint8_t { None = 0, Upper = 1, Lower = 2, Exact = 3 };
+
+/**
+ * One cached search result. `value` is in the caller's units (a scaled score,
+ * a visit-weighted mean, a finishing position...), `move` a card ID or
+ * kNoMove, `depth` the search effort behind the value.
+ */
+struct TTEntry {
+    static constexpr uint8_t kNoMove = 0xFF;
+
+    int32_t value = 0;
+    uint8_t move = kNoMove;
+    uint8_t depth = 0;
+    TTBound bound = TTBound::None;
+    uint8_t generation = 0;  // Filled in by store()
+};
+
+/**
+ * Fixed-size, lock-free position cache shared by search threads.
+ *
+ * Buckets of four 16-byte slots fill one cache line. A slot holds the packed
+ * entry and (key XOR entry) as two relaxed atomics; a reader recomputes the
+ * XOR and drops the slot unless it matches the probed key, so an entry torn
+ * by a concurrent writer reads as a miss instead of as wrong data. No locks,
+ * no read-modify-write, and a lost store costs only a cache miss.
+ *
+ * Replacement: a store to a key already in the bucket overwrites it unless
+ * the old entry is from this search and clearly deeper; otherwise the slot
+ * with the least depth, discounted by age, is evicted. newSearch() bumps the
+ * generation between moves so stale entries age out instead of being cleared.
+ *
+ * resize() and clear() must not run concurrently with probe()/store().
+ */
+class TranspositionTable {
+public:
+    static constexpr int kBucketSlots = 4;
+
+    explicit TranspositionTable(size_t megabytes = 64);
+
+    void resize(size_t megabytes);
+    void clear();
+
+    // Start of a new search (e.g. the next decision): ages existing entries
+    void newSearch() { current_generation.fetch_add(1, std::memory_order_relaxed); }
+    uint8_t generation() const { return current_generation.load(std::memory_order_relaxed); }
+
+    bool probe(uint64_t key, TTEntry& out) const;
+    void store(uint64_t key, const TTEntry& entry);
+
+    size_t bucketCount() const { return bucket_count; }
+    // Permille of sampled slots written during the current search
+    unsigned hashfull() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;  // key ^ data
+        std::atomic<uint64_t> data;
+    };
+    struct alignas(64) Bucket {
+        Slot slots[kBucketSlots];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t bucket_count = 0;
+    std::atomic<uint8_t> current_generation{0};
+
+    Bucket& bucketFor(uint64_t key) const {
+        // Multiply-shift over the full key; bucket_count need not be a power of two
+        return buckets[static_cast<size_t>((static_cast<unsigned __int128>(key) * bucket_count) >> 64)];
+    }
+
+    static uint64_t pack(const TTEntry& entry, uint8_t generation);
+    static TTEntry unpack(uint64_t data);
+};
+
+} // namespace sevens
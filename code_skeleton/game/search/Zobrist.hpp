@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../rules/GameRules.hpp"
+#include "../rules/MoveGenerator.hpp"
+#include "../../card/PackedCard.hpp"
+#include <array>
+#include <cstdint>
+
+namespace sevens {
+
+/**
+ * Zobrist keys for Sevens positions: one random 64-bit key per copy of each
+ * card on the table and per seat to move. A position hash is the XOR of the
+ * keys that apply, so playing a card or passing the turn updates it with a
+ * single XOR each:
+ *   hash ^= cardKey(card, copiesBefore);   // copy number copiesBefore goes down
+ *   hash ^= turnKey(from) ^ turnKey(to);
+ *
+ * Hands are not hashed: within one deal they follow from the table, and
+ * searches over sampled deals mix in their own deal key.
+ * The keys come from a fixed seed, so hashes are stable across runs.
+ */
+class Zobrist {
+public:
+    static const Zobrist& keys() {
+        static const Zobrist instance;
+        return instance;
+    }
+
+    uint64_t cardKey(const Card& card, int copy) const {
+        return card_keys[copy][PackedCard(card).id];
+    }
+    uint64_t cardKey(PackedCard card, int copy = 0) const { return card_keys[copy][card.id]; }
+    uint64_t turnKey(uint64_t seat) const { return turn_keys[seat]; }
+
+    // Full hash of a table (copy counts) with `turn` to move
+    uint64_t position(const TableCounts& table, uint64_t turn) const {
+        uint64_t hash = turn_keys[turn];
+        for (int suit = 0; suit < 4; suit++) {
+            for (int rank = 1; rank <= 13; rank++) {
+                for (int copy = 0; copy < table[suit][rank]; copy++) {
+                    hash ^= card_keys[copy][PackedCard(suit, rank).id];
+                }
+            }
+        }
+        return hash;
+    }
+
+    // Single-deck shortcut: bit id of `played` is card id = suit*13 + rank-1
+    uint64_t position(uint64_t played, uint64_t turn) const {
+        uint64_t hash = turn_keys[turn];
+        while (played) {
+            hash ^= card_keys[0][__builtin_ctzll(played)];
+            played &= played - 1;
+        }
+        return hash;
+    }
+
+private:
+    std::array<std::array<uint64_t, 52>, GameRules::kMaxDecks> card_keys{};
+    std::array<uint64_t, GameRules::kMaxPlayers> turn_keys{};
+
+    Zobrist() {
+        uint64_t state = 0x5EB3E5C0FFEE1234ULL;
+        auto next = [&state]() {
+            // splitmix64
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        };
+        for (auto& copies : card_keys) {
+            for (uint64_t& key : copies) key = next();
+        }
+        for (uint64_t& key : turn_keys) key = next();
+    }
+};
+
+} // namespace sevens
@@ -0,0 +1,447 @@
+#include "GameServer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace sevens {
+
+namespace {
+
+std::runtime_error socketError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+GameServer::GameServer() {
+    epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        throw socketError("Could not create the event loop");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wake_fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+}
+
+GameServer::~GameServer() {
+    stop();
+    for (int fd : listen_fds) ::close(fd);
+    if (!unix_path.empty()) ::unlink(unix_path.c_str());
+    ::close(wake_fd);
+    ::close(epoll_fd);
+}
+
+void GameServer::listenUnix(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+
+    // A socket file left behind by a previous run would make bind() fail
+    struct stat info;
+    if (::stat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) ::unlink(path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        if (fd >= 0) ::close(fd);
+        throw socketError("Could not listen on " + path);
+    }
+    unix_path = path;
+    listen_fds.push_back(fd);
+}
+
+void GameServer::listenTcp(uint16_t port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int reuse = 1;
+    if (fd >= 0) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        if (fd >= 0) ::close(fd);
+        throw socketError("Could not listen on 127.0.0.1:" + std::to_string(port));
+    }
+    listen_fds.push_back(fd);
+}
+
+void GameServer::start() {
+    if (listen_fds.empty()) {
+        throw std::runtime_error("GameServer has nothing to listen on");
+    }
+    for (int fd : listen_fds) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+    stopping = false;
+    loop = std::thread(&GameServer::run, this);
+}
+
+void GameServer::stop() {
+    if (!loop.joinable()) return;
+    stopping = true;
+    wake();
+    loop.join();
+
+    // Deliver what is queued (final Results) before hanging up
+    std::vector<Connection*> open;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& entry : connections) open.push_back(entry.second.get());
+    }
+    for (Connection* connection : open) {
+        timeval limit{1, 0};  // A bot that stopped reading cannot hold up shutdown
+        ::setsockopt(connection->fd, SOL_SOCKET, SO_SNDTIMEO, &limit, sizeof(limit));
+        ::fcntl(connection->fd, F_SETFL, ::fcntl(connection->fd, F_GETFL) & ~O_NONBLOCK);
+        writeTo(*connection);
+        drop(*connection);
+    }
+}
+
+void GameServer::waitForClients(size_t count) {
+    std::unique_lock<std::mutex> lock(mutex);
+    greeted_cv.wait(lock, [&]() { return greeted_count >= count; });
+}
+
+GameServer::Stats GameServer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void GameServer::wake() {
+    const uint64_t one = 1;
+    ssize_t ignored = ::write(wake_fd, &one, sizeof(one));
+    (void)ignored;
+}
+
+GameServer::Connection* GameServer::boundTo(uint64_t gameId, uint64_t seat) {
+    auto it = bound.find(seatKey(gameId, seat));
+    if (it == bound.end()) return nullptr;
+    auto connection = connections.find(it->second);
+    return connection == connections.end() ? nullptr : connection->second.get();
+}
+
+void GameServer::markDirty(Connection& connection) {
+    if (connection.out.empty()) dirty.push_back(connection.id);
+}
+
+void GameServer::onGameStart(uint64_t gameId, const GameStartInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Least busy bot; none means the seat plays by the engine's policy
+    Connection* chosen = nullptr;
+    for (auto& entry : connections) {
+        Connection& connection = *entry.second;
+        if (connection.greeted && (!chosen || connection.seats < chosen->seats)) chosen = &connection;
+    }
+    if (!chosen) return;
+    bound[seatKey(gameId, info.seat)] = chosen->id;
+    chosen->seats++;
+
+    markDirty(*chosen);
+    FrameWriter frame(chosen->out, MessageType::Deal);
+    frame.u64(gameId).u8(static_cast<uint8_t>(info.seat)).u8(static_cast<uint8_t>(info.numPlayers))
+         .u8(static_cast<uint8_t>(info.numDecks)).u64(info.dealSeed);
+    for (uint64_t size : info.handSizes) frame.u16(static_cast<uint16_t>(size));
+    frame.cards(info.tableCards).cards(info.hand);
+    frame.finish();
+}
+
+void GameServer::onMove(uint64_t gameId, uint64_t seat, uint64_t playerID, const Card& card) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Connection* connection = boundTo(gameId, seat);
+    if (!connection) return;
+    markDirty(*connection);
+    FrameWriter(connection->out, MessageType::Moved)
+        .u64(gameId).u8(static_cast<uint8_t>(seat)).u8(static_cast<uint8_t>(playerID)).card(card).finish();
+}
+
+void GameServer::onPass(uint64_t gameId, uint64_t seat, uint64_t playerID) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Connection* connection = boundTo(gameId, seat);
+    if (!connection) return;
+    markDirty(*connection);
+    FrameWriter(connection->out, MessageType::Passed)
+        .u64(gameId).u8(static_cast<uint8_t>(seat)).u8(static_cast<uint8_t>(playerID)).finish();
+}
+
+void GameServer::onGameEnd(uint64_t gameId, uint64_t seat, uint64_t finalRank) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Connection* connection = boundTo(gameId, seat);
+    bound.erase(seatKey(gameId, seat));
+    if (!connection) return;
+    connection->seats--;
+    markDirty(*connection);
+    FrameWriter(connection->out, MessageType::Result)
+        .u64(gameId).u8(static_cast<uint8_t>(seat)).u8(static_cast<uint8_t>(finalRank)).finish();
+}
+
+void GameServer::request(DecisionRequest& request) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Connection* connection = boundTo(request.gameId, request.seat);
+        if (connection) {
+            markDirty(*connection);
+            FrameWriter(connection->out, MessageType::Turn)
+                .u64(request.gameId).u8(static_cast<uint8_t>(request.seat)).cards(*request.validMoves).finish();
+            pending[seatKey(request.gameId, request.seat)] =
+                Pending{&request, connection->id, std::chrono::steady_clock::now() + move_timeout};
+            return;
+        }
+        counters.orphaned++;
+    }
+    request.complete(-1);
+}
+
+void GameServer::flush() {
+    bool any;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        any = !dirty.empty();
+    }
+    if (any) wake();
+}
+
+void GameServer::run() {
+    epoll_event events[256];
+    while (!stopping) {
+        const int count = ::epoll_wait(epoll_fd, events, 256, 20);
+        for (int i = 0; i < count; i++) {
+            const int fd = events[i].data.fd;
+            if (fd == wake_fd) {
+                uint64_t value;
+                ssize_t ignored = ::read(wake_fd, &value, sizeof(value));
+                (void)ignored;
+                continue;
+            }
+            if (std::find(listen_fds.begin(), listen_fds.end(), fd) != listen_fds.end()) {
+                accept(fd);
+                continue;
+            }
+
+            Connection* connection = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = by_fd.find(fd);
+                if (it != by_fd.end()) connection = connections.at(it->second).get();
+            }
+            if (!connection) continue;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) readFrom(*connection);
+            // A closing connection still gets its last Error message, if the socket takes it
+            if (connection->closed || (events[i].events & EPOLLOUT)) writeTo(*connection);
+            if (connection->closed) drop(*connection);
+        }
+
+        // Send whatever the schedulers queued since the last round
+        std::vector<uint32_t> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.swap(dirty);
+        }
+        for (uint32_t id : ready) {
+            Connection* connection = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = connections.find(id);
+                if (it != connections.end()) connection = it->second.get();
+            }
+            if (!connection) continue;
+            writeTo(*connection);
+            if (connection->closed) drop(*connection);
+        }
+        expire();
+    }
+}
+
+void GameServer::accept(int listenFd) {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;  // EAGAIN: no more pending connections
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));  // Fails harmlessly on Unix sockets
+
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            connection->id = next_id++;
+            by_fd[fd] = connection->id;
+            connections[connection->id] = std::move(connection);
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void GameServer::readFrom(Connection& connection) {
+    char chunk[65536];
+    while (true) {
+        ssize_t n = ::recv(connection.fd, chunk, sizeof(chunk), 0);
+        if (n > 0) {
+            connection.in.append(chunk, static_cast<size_t>(n));
+            std::lock_guard<std::mutex> lock(mutex);
+            counters.bytesIn += static_cast<uint64_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) connection.closed = true;
+        break;
+    }
+
+    size_t offset = 0;
+    try {
+        MessageType type;
+        const char* payload;
+        size_t size;
+        while (size_t used = peekFrame(connection.in, offset, type, payload, size)) {
+            handleFrame(connection, type, payload, size);
+            offset += used;
+        }
+    } catch (const std::runtime_error& e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.protocolErrors++;
+        markDirty(connection);
+        FrameWriter(connection.out, MessageType::Error).text(e.what()).finish();
+        connection.closed = true;
+    }
+    connection.in.erase(0, offset);
+}
+
+void GameServer::handleFrame(Connection& connection, MessageType type, const char* payload, size_t size) {
+    FrameReader reader(payload, size);
+    if (type == MessageType::Hello) {
+        const uint16_t version = reader.u16();
+        if (version != kProtocolVersion) {
+            throw std::runtime_error("Unsupported protocol version " + std::to_string(version));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!connection.greeted) {
+            connection.greeted = true;
+            connection.name = reader.rest();
+            greeted_count++;
+            counters.clients++;
+            markDirty(connection);
+            FrameWriter(connection.out, MessageType::Welcome).u32(connection.id).u16(kProtocolVersion).finish();
+            greeted_cv.notify_all();
+        }
+        return;
+    }
+    if (type != MessageType::Move || !connection.greeted) {
+        throw std::runtime_error("Unexpected message type " + std::to_string(static_cast<int>(type)));
+    }
+
+    const uint64_t gameId = reader.u64();
+    const uint8_t seat = reader.u8();
+    const int16_t index = static_cast<int16_t>(reader.u16());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = pending.find(seatKey(gameId, seat));
+    if (it == pending.end() || it->second.client != connection.id) {
+        // Late answer to a timed-out turn, or a bug in the bot: report, keep going
+        counters.protocolErrors++;
+        markDirty(connection);
+        FrameWriter(connection.out, MessageType::Error)
+            .text("No turn pending for game " + std::to_string(gameId) + " seat " + std::to_string(seat))
+            .finish();
+        return;
+    }
+    DecisionRequest* request = it->second.request;
+    pending.erase(it);
+    counters.decisions++;
+    request->complete(index);
+}
+
+void GameServer::writeTo(Connection& connection) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        connection.sending += connection.out;
+        connection.out.clear();
+    }
+    size_t sent = 0;
+    while (sent < connection.sending.size()) {
+        ssize_t n = ::send(connection.fd, connection.sending.data() + sent, connection.sending.size() - sent,
+                           MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) connection.closed = true;
+        break;
+    }
+    connection.sending.erase(0, sent);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.bytesOut += sent;
+    }
+
+    // Ask epoll for writability only while the socket is backed up
+    const bool backlog = !connection.sending.empty() && !connection.closed;
+    if (backlog != connection.want_write) {
+        connection.want_write = backlog;
+        epoll_event event{};
+        event.events = backlog ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        event.data.fd = connection.fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+}
+
+void GameServer::drop(Connection& connection) {
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, connection.fd, nullptr);
+    ::close(connection.fd);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (connection.greeted) greeted_count--;
+    // Its open turns get the engine's fallback; its games go on without it
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (it->second.client == connection.id) {
+            counters.orphaned++;
+            it->second.request->complete(-1);
+            it = pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    by_fd.erase(connection.fd);
+    connections.erase(connection.id);  // Destroys `connection`
+}
+
+void GameServer::expire() {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (it->second.deadline <= now) {
+            counters.timeouts++;
+            it->second.request->complete(-1);
+            it = pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace sevens
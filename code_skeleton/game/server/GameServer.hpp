@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../async/AsyncGameDriver.hpp"
+#include "Protocol.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Plays the remote seats of scheduled games through bots connected over
+ * Unix domain sockets or TCP on localhost (wire format in Protocol.hpp).
+ *
+ * The server is a DecisionSource: give it to GameScheduler for every seat
+ * a bot should play. Each (game, seat) is bound to one connection when the
+ * game starts. The least busy bot gets it, and the bot then receives that
+ * seat's Deal, observations, Turns and Result. One epoll thread does all
+ * socket I/O. Messages produced by the schedulers are buffered per
+ * connection and written in bulk each time a scheduler flushes, so a wave
+ * of decisions across thousands of games costs one write per bot.
+ *
+ * Decisions a bot does not answer within the move timeout, and those of
+ * a bot that disconnects, are answered with -1. The engine then plays
+ * per its IllegalMovePolicy. A game whose bot is gone is finished that
+ * way without further messages.
+ */
+class GameServer : public DecisionSource {
+public:
+    GameServer();
+    ~GameServer() override;
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Listen on a Unix socket path (replacing a stale socket file) and/or on
+    // 127.0.0.1:port. Call before start(); throws std::runtime_error.
+    void listenUnix(const std::string& path);
+    void listenTcp(uint16_t port);
+
+    void setMoveTimeout(std::chrono::milliseconds timeout) { move_timeout = timeout; }
+
+    // Run the event loop on a background thread
+    void start();
+    // Close every connection and stop the event loop
+    void stop();
+
+    // Block until at least `count` bots have said Hello
+    void waitForClients(size_t count);
+
+    // DecisionSource
+    void request(DecisionRequest& request) override;
+    void flush() override;
+    bool wantsEvents() const override { return true; }
+    void onGameStart(uint64_t gameId, const GameStartInfo& info) override;
+    void onMove(uint64_t gameId, uint64_t seat, uint64_t playerID, const Card& card) override;
+    void onPass(uint64_t gameId, uint64_t seat, uint64_t playerID) override;
+    void onGameEnd(uint64_t gameId, uint64_t seat, uint64_t finalRank) override;
+
+    struct Stats {
+        uint64_t clients = 0;      // Bots that said Hello so far
+        uint64_t decisions = 0;    // Answered by a bot
+        uint64_t timeouts = 0;     // Answered with -1 after the move timeout
+        uint64_t orphaned = 0;     // Answered with -1 because the bot had gone
+        uint64_t protocolErrors = 0;
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+    };
+    Stats stats() const;
+
+private:
+    struct Connection {
+        int fd = -1;
+        uint32_t id = 0;
+        bool greeted = false;
+        bool closed = false;
+        bool want_write = false;  // EPOLLOUT armed
+        uint64_t seats = 0;       // (game, seat) pairs bound to it
+        std::string name;
+        std::string in;
+        std::string out;          // Queued by the schedulers; guarded by the server mutex
+        std::string sending;      // Taken from `out`, not yet accepted by the socket
+    };
+
+    struct Pending {
+        DecisionRequest* request;
+        uint32_t client;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    int epoll_fd = -1;
+    int wake_fd = -1;
+    std::vector<int> listen_fds;
+    std::string unix_path;
+    std::chrono::milliseconds move_timeout{5000};
+    std::thread loop;
+    std::atomic<bool> stopping{false};
+
+    mutable std::mutex mutex;
+    std::condition_variable greeted_cv;
+    std::unordered_map<uint32_t, std::unique_ptr<Connection>> connections;
+    std::unordered_map<int, uint32_t> by_fd;
+    std::unordered_map<uint64_t, uint32_t> bound;     // seatKey -> client
+    std::unordered_map<uint64_t, Pending> pending;    // seatKey -> open decision
+    std::vector<uint32_t> dirty;                      // Clients with unsent output
+    uint32_t next_id = 1;
+    size_t greeted_count = 0;  // Connected bots that said Hello
+    Stats counters;
+
+    static uint64_t seatKey(uint64_t gameId, uint64_t seat) { return gameId << 8 | seat; }
+
+    void run();
+    void accept(int listenFd);
+    void readFrom(Connection& connection);
+    void handleFrame(Connection& connection, MessageType type, const char* payload, size_t size);
+    void writeTo(Connection& connection);
+    void drop(Connection& connection);
+    void expire();
+    void wake();
+    // Client bound to (gameId, seat), or nullptr; requires the mutex
+    Connection* boundTo(uint64_t gameId, uint64_t seat);
+    void markDirty(Connection& connection);
+};
+
+} // namespace sevens
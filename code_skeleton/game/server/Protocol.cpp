@@ -0,0 +1,97 @@
+#include "Protocol.hpp"
+#include <stdexcept>
+
+namespace sevens {
+
+FrameWriter::FrameWriter(std::string& out, MessageType type) : out(out), start(out.size()) {
+    out.append(4, '\0');
+    out.push_back(static_cast<char>(type));
+}
+
+FrameWriter& FrameWriter::u8(uint8_t value) {
+    out.push_back(static_cast<char>(value));
+    return *this;
+}
+
+FrameWriter& FrameWriter::u16(uint16_t value) {
+    for (int i = 0; i < 2; i++) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    return *this;
+}
+
+FrameWriter& FrameWriter::u32(uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    return *this;
+}
+
+FrameWriter& FrameWriter::u64(uint64_t value) {
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    return *this;
+}
+
+FrameWriter& FrameWriter::cards(const std::vector<Card>& cards) {
+    u16(static_cast<uint16_t>(cards.size()));
+    for (const Card& c : cards) card(c);
+    return *this;
+}
+
+FrameWriter& FrameWriter::text(const std::string& text) {
+    out += text;
+    return *this;
+}
+
+void FrameWriter::finish() {
+    const uint32_t length = static_cast<uint32_t>(out.size() - start - 4);
+    for (int i = 0; i < 4; i++) out[start + i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+}
+
+uint64_t FrameReader::read(int bytes) {
+    if (pos + bytes > size) {
+        throw std::runtime_error("Truncated message");
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+    pos += bytes;
+    return value;
+}
+
+uint8_t FrameReader::u8() { return static_cast<uint8_t>(read(1)); }
+uint16_t FrameReader::u16() { return static_cast<uint16_t>(read(2)); }
+uint32_t FrameReader::u32() { return static_cast<uint32_t>(read(4)); }
+uint64_t FrameReader::u64() { return read(8); }
+
+Card FrameReader::card() {
+    Card card = decodeCard(u8());
+    if (card.suit > 3 || card.rank < 1 || card.rank > 13) {
+        throw std::runtime_error("Invalid card in message");
+    }
+    return card;
+}
+
+std::vector<Card> FrameReader::cards() {
+    std::vector<Card> result(u16());
+    for (Card& c : result) c = card();
+    return result;
+}
+
+std::string FrameReader::rest() {
+    std::string text(data + pos, size - pos);
+    pos = size;
+    return text;
+}
+
+size_t peekFrame(const std::string& buffer, size_t offset, MessageType& type, const char*& payload,
+                 size_t& payloadSize) {
+    if (buffer.size() - offset < 4) return 0;
+    uint32_t length = 0;
+    for (int i = 0; i < 4; i++) length |= static_cast<uint32_t>(static_cast<uint8_t>(buffer[offset + i])) << (8 * i);
+    if (length == 0 || length > kMaxFrameSize) {
+        throw std::runtime_error("Bad frame length " + std::to_string(length));
+    }
+    if (buffer.size() - offset - 4 < length) return 0;
+    type = static_cast<MessageType>(buffer[offset + 4]);
+    payload = buffer.data() + offset + 5;
+    payloadSize = length - 1;
+    return 4 + length;
+}
+
+} // namespace sevens
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../../card/Generic_card_parser.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Wire format between the game server and remote bots (any language).
+ *
+ * A stream of frames: length:u32 (of what follows), type:u8, payload.
+ * Integers are little-endian. A card is one byte: suit << 4 | rank, with
+ * suit 0..3 (clubs, diamonds, hearts, spades) and rank 1..13. A card list
+ * is count:u16 followed by that many cards.
+ *
+ * Bot -> server
+ *   Hello   version:u16, name (rest of the frame)
+ *   Move    game:u64, seat:u8, index:i16     index into the Turn's moves
+ *
+ * Server -> bot (every game message names the game and the bot's seat)
+ *   Welcome client:u32, version:u16
+ *   Deal    game:u64, seat:u8, players:u8, decks:u8, seed:u64,
+ *           hand sizes (players x u16), table cards, hand cards
+ *   Turn    game:u64, seat:u8, moves (card list)
+ *   Moved   game:u64, seat:u8, player:u8, card      someone played a card
+ *   Passed  game:u64, seat:u8, player:u8            someone passed
+ *   Result  game:u64, seat:u8, rank:u8              the game is over for this seat
+ *   Error   message (rest of the frame)
+ *
+ * A bot may play many seats of many games at once: it answers each Turn
+ * with one Move, in any order. Passes are automatic and never reach the
+ * bot as a Turn.
+ */
+enum class MessageType : uint8_t {
+    Hello = 1,
+    Move = 2,
+    Welcome = 64,
+    Deal = 65,
+    Turn = 66,
+    Moved = 67,
+    Passed = 68,
+    Result = 69,
+    Error = 70
+};
+
+constexpr uint16_t kProtocolVersion = 1;
+constexpr uint32_t kMaxFrameSize = 1 << 16;
+
+inline uint8_t encodeCard(const Card& card) {
+    return static_cast<uint8_t>(card.suit << 4 | card.rank);
+}
+
+inline Card decodeCard(uint8_t byte) {
+    return Card{byte >> 4, byte & 0x0F};
+}
+
+// Builds one frame; finish() patches in the length
+class FrameWriter {
+public:
+    FrameWriter(std::string& out, MessageType type);
+
+    FrameWriter& u8(uint8_t value);
+    FrameWriter& u16(uint16_t value);
+    FrameWriter& u32(uint32_t value);
+    FrameWriter& u64(uint64_t value);
+    FrameWriter& card(const Card& card) { return u8(encodeCard(card)); }
+    FrameWriter& cards(const std::vector<Card>& cards);
+    FrameWriter& text(const std::string& text);
+    void finish();
+
+private:
+    std::string& out;
+    size_t start;
+};
+
+// Reads one frame's payload; throws std::runtime_error past its end
+class FrameReader {
+public:
+    FrameReader(const char* data, size_t size) : data(data), size(size) {}
+
+    uint8_t u8();
+    uint16_t u16();
+    uint32_t u32();
+    uint64_t u64();
+    Card card();
+    std::vector<Card> cards();
+    std::string rest();
+
+private:
+    const char* data;
+    size_t size;
+    size_t pos = 0;
+
+    uint64_t read(int bytes);
+};
+
+// If `buffer` starts with a whole frame, return its type and payload bounds
+// and the number of bytes it spans; 0 if more data is needed. Throws
+// std::runtime_error on an oversized or empty frame.
+size_t peekFrame(const std::string& buffer, size_t offset, MessageType& type, const char*& payload,
+                 size_t& payloadSize);
+
+} // namespace sevens
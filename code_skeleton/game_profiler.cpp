@@ -0,0 +1,228 @@
+#include "game/analysis/GameProfile.hpp"
+#include "game/mapper/MyGameMapper.hpp"
+#include "strat/GreedyStrategy.hpp"
+#include "strat/RandomStrategy.hpp"
+#include "strat/RLStrategy.hpp"
+#include "strat/StrategyLoader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Game-tree profiler: plays a large sample of games and reports where the
+ * decisions are.
+ *
+ *   ./game_profiler [--players N] [--games N] [--seats greedy,random,rl:model.dat,lib.so,...]
+ *                   [--rules file] [--seed S] [--threads T] [--bench N]
+ *
+ * Reported: the distribution of legal moves per turn, forced-move and pass
+ * rates per seat, game lengths, and per strategy how many of its calls had
+ * only one answer (calls the engine's forced-move shortcut skips), the time
+ * they took and how often the strategy did not return that answer.
+ *
+ * --bench N then plays N ordinary games with the shortcut on and N with it
+ * off (same seeds, one thread) to measure what it saves.
+ */
+
+static std::shared_ptr<PlayerStrategy> makeStrategy(const std::string& spec) {
+    if (spec == "random") return std::make_shared<RandomStrategy>();
+    if (spec == "greedy") return std::make_shared<GreedyStrategy>();
+    if (spec.rfind("rl", 0) == 0) {
+        auto rl = std::make_shared<RLStrategy>();
+        if (spec.size() > 3 && spec[2] == ':') rl->loadModel(spec.substr(3));
+        return rl;
+    }
+    if (spec.size() > 3 && spec.compare(spec.size() - 3, 3, ".so") == 0) {
+        return StrategyLoader::loadFromLibrary(spec);
+    }
+    throw std::invalid_argument("Unknown strategy: " + spec);
+}
+
+static double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+
+// Mean and a few quantiles of a histogram indexed by value
+static void printDistribution(const std::string& title, const std::vector<uint64_t>& histogram) {
+    uint64_t total = 0, sum = 0;
+    for (size_t value = 0; value < histogram.size(); value++) {
+        total += histogram[value];
+        sum += value * histogram[value];
+    }
+    if (total == 0) return;
+
+    auto quantile = [&](double q) {
+        const uint64_t target = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t value = 0; value < histogram.size(); value++) {
+            seen += histogram[value];
+            if (seen >= target) return value;
+        }
+        return histogram.size() - 1;
+    };
+    std::cout << title << ": mean " << static_cast<double>(sum) / total << ", min " << quantile(0.0) << ", p50 "
+              << quantile(0.5) << ", p90 " << quantile(0.9) << ", max " << quantile(1.0) << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t numPlayers = 4;
+    uint64_t games = 100000;
+    std::string seatsSpec = "greedy,random,random,random";
+    std::string rulesPath;
+    uint64_t seed = 1;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t bench = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--games") games = std::stoull(argv[++i]);
+            else if (arg == "--seats") seatsSpec = argv[++i];
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else if (arg == "--threads") threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            else if (arg == "--bench") bench = std::stoull(argv[++i]);
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        if (threads == 0) threads = 1;
+
+        MyGameMapper prototype;
+        prototype.read_cards("");
+        prototype.read_game(rulesPath);
+        prototype.getRules().validate(numPlayers);
+
+        std::vector<std::string> names;
+        std::stringstream list(seatsSpec);
+        std::string spec;
+        while (std::getline(list, spec, ',')) {
+            if (spec.empty()) throw std::invalid_argument("--seats has an empty seat: " + seatsSpec);
+            names.push_back(spec);
+        }
+        if (names.empty()) throw std::invalid_argument("--seats needs at least one strategy");
+        for (uint64_t seat = names.size(); seat < numPlayers; seat++) names.push_back(names[seat % names.size()]);
+        names.resize(numPlayers);
+
+        // Each thread plays with its own strategies; seeds match batch runs with --seed
+        GameProfile profile;
+        std::mutex mutex;
+        std::atomic<uint64_t> next{0};
+        std::exception_ptr failure;
+        auto work = [&]() {
+            try {
+                std::vector<std::shared_ptr<PlayerStrategy>> seats;
+                for (const std::string& name : names) seats.push_back(makeStrategy(name));
+                GameProfiler profiler(prototype, seats, names);
+                GameProfile local;
+                for (uint64_t game = next++; game < games; game = next++) {
+                    profiler.play(seed * 0x9E3779B97F4A7C15ULL + game, local);
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                profile.merge(local);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) failure = std::current_exception();
+                next = games;
+            }
+        };
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) workers.emplace_back(work);
+        for (auto& worker : workers) worker.join();
+        if (failure) std::rethrow_exception(failure);
+
+        uint64_t turns = 0;
+        for (uint64_t n : profile.legalMoves) turns += n;
+        const uint64_t passes = profile.legalMoves.empty() ? 0 : profile.legalMoves[0];
+        const uint64_t forced = profile.legalMoves.size() > 1 ? profile.legalMoves[1] : 0;
+
+        std::cout << "\n=== Profile of " << profile.games << " games, " << numPlayers << " players ===\n";
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Turns: " << turns << " (" << static_cast<double>(turns) / std::max<uint64_t>(profile.games, 1)
+                  << " per game), passes " << percent(passes, turns) << "%, forced " << percent(forced, turns)
+                  << "%, real decisions " << percent(turns - passes - forced, turns) << "%\n";
+
+        std::cout << "\nLegal moves per turn:\n";
+        uint64_t branchSum = 0;
+        for (size_t n = 0; n < profile.legalMoves.size(); n++) {
+            branchSum += n * profile.legalMoves[n];
+            if (profile.legalMoves[n] == 0) continue;
+            std::cout << std::setw(4) << n << std::setw(14) << profile.legalMoves[n] << std::setw(9)
+                      << percent(profile.legalMoves[n], turns) << "%\n";
+        }
+        if (turns > passes) {
+            std::cout << "Mean branching when not passing: "
+                      << static_cast<double>(branchSum) / static_cast<double>(turns - passes) << "\n";
+        }
+
+        std::cout << "\nPer seat:\n";
+        for (size_t seat = 0; seat < profile.seats.size(); seat++) {
+            const GameProfile::Seat& s = profile.seats[seat];
+            std::cout << "Seat " << seat << " (" << names[seat] << "): " << s.turns << " turns, pass rate "
+                      << percent(s.passes, s.turns) << "%, forced " << percent(s.forced, s.turns) << "%\n";
+        }
+
+        std::cout << std::defaultfloat << std::setprecision(4) << "\n";
+        printDistribution("Cards played per game", profile.gameLengths);
+        printDistribution("Rounds per game", profile.roundCounts);
+
+        std::cout << std::fixed << std::setprecision(2) << "\nStrategy calls:\n";
+        for (const auto& [name, s] : profile.strategies) {
+            std::cout << name << ": " << s.calls << " calls, " << percent(s.forcedCalls, s.calls)
+                      << "% forced (" << percent(s.forcedNanos, s.callNanos) << "% of decision time), "
+                      << s.forcedDiffered << " forced answers other than the only move\n";
+        }
+        std::cout << std::defaultfloat;
+
+        if (bench > 0) {
+            // Plain games through compute_game_progress, both ways, same seeds
+            auto timeRun = [&](bool shortcut) {
+                MyGameMapper mapper = prototype;
+                mapper.setForcedMoveShortcut(shortcut);
+                for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                    mapper.registerStrategy(seat, makeStrategy(names[seat]));
+                }
+                const auto start = std::chrono::steady_clock::now();
+                for (uint64_t game = 0; game < bench; game++) {
+                    mapper.setDealSeed(seed * 0x9E3779B97F4A7C15ULL + game);
+                    mapper.compute_game_progress(numPlayers);
+                }
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                return bench / (seconds > 0 ? seconds : 1e-9);
+            };
+            const double off = timeRun(false);
+            const double on = timeRun(true);
+            std::cout << "\nForced-move shortcut: " << static_cast<uint64_t>(off) << " games/sec off, "
+                      << static_cast<uint64_t>(on) << " games/sec on (" << std::fixed << std::setprecision(1)
+                      << 100.0 * (on / off - 1.0) << "%)\n" << std::defaultfloat;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[game_profiler] " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "game/async/AsyncGameDriver.hpp"
+#include "game/server/GameServer.hpp"
+#include "strat/GreedyStrategy.hpp"
+#include "strat/RandomStrategy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Game server: hosts many concurrent tables whose remote seats are played
+ * by bots in other processes (any language; wire format in
+ * game/server/Protocol.hpp).
+ *
+ *   ./game_server [--unix path] [--tcp port] [--seats remote,greedy,...]
+ *                 [--players N] [--games N] [--in-flight K] [--threads T]
+ *                 [--clients C] [--move-timeout-ms M] [--rules file] [--seed S]
+ *
+ * Listens on --unix (default sevens.sock) and, if given, 127.0.0.1:--tcp.
+ * Once C bots have connected it plays the games on T scheduler threads,
+ * each keeping K games in flight. Seats marked "remote" go to the bots,
+ * spread over the connections; "greedy" and "random" seats play in
+ * process. See bot_client.cpp for a client.
+ */
+
+int main(int argc, char* argv[]) {
+    std::string unixPath = "sevens.sock";
+    int tcpPort = -1;
+    std::string seatsSpec = "remote,greedy,greedy,greedy";
+    uint64_t numPlayers = 4;
+    uint64_t games = 10000;
+    uint64_t inFlight = 1000;
+    unsigned threads = 1;
+    uint64_t clients = 1;
+    uint64_t moveTimeoutMs = 5000;
+    std::string rulesPath;
+    uint64_t seed = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--unix") unixPath = argv[++i];
+            else if (arg == "--tcp") tcpPort = std::stoi(argv[++i]);
+            else if (arg == "--seats") seatsSpec = argv[++i];
+            else if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--games") games = std::stoull(argv[++i]);
+            else if (arg == "--in-flight") inFlight = std::stoull(argv[++i]);
+            else if (arg == "--threads") threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            else if (arg == "--clients") clients = std::stoull(argv[++i]);
+            else if (arg == "--move-timeout-ms") moveTimeoutMs = std::stoull(argv[++i]);
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        if (threads == 0) threads = 1;
+        MyGameMapper prototype;
+        prototype.read_cards("");
+        prototype.read_game(rulesPath);
+        prototype.getRules().validate(numPlayers);
+
+        // Seat sources; the list is repeated if shorter than the table
+        std::vector<std::string> specs;
+        std::stringstream list(seatsSpec);
+        std::string spec;
+        while (std::getline(list, spec, ',')) specs.push_back(spec);
+        if (specs.empty()) {
+            throw std::invalid_argument("--seats needs at least one seat (remote, greedy or random)");
+        }
+        std::vector<std::string> names;
+        for (uint64_t seat = 0; seat < numPlayers; seat++) {
+            const std::string& seatSpec = specs[seat % specs.size()];
+            if (seatSpec != "remote" && seatSpec != "greedy" && seatSpec != "random") {
+                throw std::invalid_argument("Unknown seat: " + seatSpec + " (remote, greedy or random)");
+            }
+            names.push_back(seatSpec);
+        }
+
+        GameServer server;
+        if (!unixPath.empty()) server.listenUnix(unixPath);
+        if (tcpPort >= 0) server.listenTcp(static_cast<uint16_t>(tcpPort));
+        server.setMoveTimeout(std::chrono::milliseconds(moveTimeoutMs));
+        server.start();
+
+        std::cout << "Listening on " << unixPath << (tcpPort >= 0 ? " and 127.0.0.1:" + std::to_string(tcpPort) : "")
+                  << ", waiting for " << clients << " bot(s)" << std::endl;
+        server.waitForClients(clients);
+        std::cout << "Playing " << games << " games on " << threads << " thread(s), " << inFlight
+                  << " in flight each" << std::endl;
+
+        // Each thread schedules its own slice of the games; the server is shared
+        std::mutex results_mutex;
+        std::vector<uint64_t> wins(numPlayers, 0);
+        std::vector<uint64_t> rankSum(numPlayers, 0);
+        std::exception_ptr failure;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                const uint64_t first = games * t / threads;
+                const uint64_t count = games * (t + 1) / threads - first;
+                try {
+                    // In-process seats are per thread; strategies are not thread-safe
+                    StrategySource greedy(std::make_shared<GreedyStrategy>());
+                    StrategySource random(std::make_shared<RandomStrategy>());
+                    std::vector<DecisionSource*> seats;
+                    for (const std::string& name : names) {
+                        seats.push_back(name == "remote" ? static_cast<DecisionSource*>(&server)
+                                        : name == "greedy" ? &greedy : &random);
+                    }
+                    GameScheduler scheduler(prototype);
+                    scheduler.setSeats(seats);
+                    scheduler.setGameIdBase(first);
+                    scheduler.run(numPlayers, count, seed + first, std::max<uint64_t>(inFlight, 1),
+                                  [&](const AsyncGameResult& result) {
+                        std::lock_guard<std::mutex> lock(results_mutex);
+                        for (const auto& ranking : result.rankings) {
+                            rankSum[ranking.first] += ranking.second;
+                            if (ranking.second == 1) wins[ranking.first]++;
+                        }
+                    });
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(results_mutex);
+                    if (!failure) failure = std::current_exception();
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        server.stop();
+        if (failure) std::rethrow_exception(failure);
+
+        const GameServer::Stats stats = server.stats();
+        std::cout << "\n=== Server results: " << games << " games, "
+                  << static_cast<uint64_t>(games / (seconds > 0 ? seconds : 1)) << " games/sec ===\n";
+        std::cout << "Bots: " << stats.clients << " connected, " << stats.decisions << " decisions, "
+                  << stats.timeouts << " timed out, " << stats.orphaned << " without a bot, "
+                  << stats.protocolErrors << " protocol errors\n";
+        std::cout << "Traffic: " << stats.bytesIn << " bytes in, " << stats.bytesOut << " bytes out\n";
+        for (uint64_t seat = 0; seat < numPlayers; seat++) {
+            std::cout << "Seat " << seat << " (" << names[seat] << "): win rate "
+                      << static_cast<double>(wins[seat]) / games << ", average rank "
+                      << static_cast<double>(rankSum[seat]) / games << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[game_server] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
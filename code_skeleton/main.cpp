@@ -6,6 +6,7 @@
 #include "strat/RLStrategy.hpp"
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 #include <string>
 
@@ -30,7 +31,11 @@ int main() {
     // gameMapper->registerStrategy(1, std::make_shared<RLStrategy>());
     
     auto rlStrategy = std::make_shared<RLStrategy>();
-    rlStrategy->loadModel("rl_model_60000.dat");  // Load the saved model
+    try {
+        rlStrategy->loadModel("rl_model_final.dat");  // Load the saved model
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Warning: " << e.what() << "; RL player starts untrained" << std::endl;
+    }
     gameMapper->registerStrategy(1, rlStrategy);  // Register with loaded weights
     
     gameMapper->registerStrategy(2, std::make_shared<RandomStrategy>());
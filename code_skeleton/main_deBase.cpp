@@ -15,34 +15,59 @@ using namespace sevens;
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         std::cout << "Usage: ./sevens_game [mode] [optional libs...]\n";
-        std::cout << "  Modes: internal, demo, competition\n";
+        std::cout << "  Modes: internal [numPlayers] [numDecks | rulesFile], demo, competition\n";
         return 1;
     }
     
     std::string mode = argv[1];
     
     if (mode == "internal") {
-        std::cout << "[main] Running internal mode with 4 random players\n";
+        // Optional table: ./sevens_game internal [numPlayers] [numDecks | rulesFile]
+        uint64_t numPlayers = 4;
+        std::string tableArg = (argc > 3) ? argv[3] : "";
+        bool deckCount = !tableArg.empty() &&
+            tableArg.find_first_not_of("0123456789") == std::string::npos;
         
         auto gameMapper = std::make_unique<MyGameMapper>();
         gameMapper->read_cards("");
-        gameMapper->read_game("");
-        
-        // Internal mode uses 4 random players
-        gameMapper->registerStrategy(0, std::make_shared<RandomStrategy>());
-        gameMapper->registerStrategy(1, std::make_shared<RandomStrategy>());
-        gameMapper->registerStrategy(2, std::make_shared<RandomStrategy>());
-        gameMapper->registerStrategy(3, std::make_shared<RandomStrategy>());
+        try {
+            if (argc > 2) numPlayers = std::stoull(argv[2]);
+            gameMapper->read_game(deckCount ? "" : tableArg);
+            if (deckCount) {
+                GameRules rules = gameMapper->getRules();
+                rules.numDecks = std::stoull(tableArg);
+                gameMapper->setRules(rules);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[main] " << e.what() << std::endl;
+            return 1;
+        }
         
-        std::vector<std::string> playerNames = {
-            "Random-0", "Random-1", "Random-2", "Random-3"
-        };
+        std::cout << "[main] Running internal mode with " << numPlayers
+                  << " random players and " << gameMapper->getRules().numDecks << " deck(s)\n";
         
-        auto results = gameMapper->compute_and_display_game(playerNames);
+        // Internal mode uses random players only
+        std::vector<std::string> playerNames;
+        for (uint64_t i = 0; i < numPlayers; i++) {
+            gameMapper->registerStrategy(i, std::make_shared<RandomStrategy>());
+            playerNames.push_back("Random-" + std::to_string(i));
+        }
         
-        std::cout << "[main] Final Rankings:\n";
-        for (const auto& result : results) {
-            std::cout << "  " << result.first << " -> Rank " << result.second << "\n";
+        try {
+            auto results = gameMapper->compute_and_display_game(playerNames);
+            
+            std::cout << "[main] Final Rankings:\n";
+            for (size_t i = 0; i < results.size(); i++) {
+                std::cout << "  " << results[i].first << " -> Rank " << results[i].second;
+                if (gameMapper->getRules().passPenalty > 0 || gameMapper->getRules().cardPenalty > 0) {
+                    uint64_t seat = std::stoull(results[i].first.substr(results[i].first.rfind('-') + 1));
+                    std::cout << " (" << gameMapper->getChipBalances()[seat] << " chips)";
+                }
+                std::cout << "\n";
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[main] " << e.what() << std::endl;
+            return 1;
         }
     }
     else if (mode == "demo") {
@@ -92,7 +117,6 @@ int main(int argc, char* argv[]) {
             try {
                 auto strategy = StrategyLoader::loadFromLibrary(libPath);
                 uint64_t playerID = i - 2;
-                strategy->initialize(playerID);
                 gameMapper->registerStrategy(playerID, strategy);
                 std::string name = strategy->getName() + "-" + std::to_string(playerID);
                 playerNames.push_back(name);
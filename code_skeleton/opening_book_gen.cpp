@@ -0,0 +1,237 @@
+#include "game/mapper/MyGameMapper.hpp"
+#include "strat/GreedyStrategy.hpp"
+#include "strat/OpeningBook.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Opening book generator: plays every candidate first move of every seat
+ * over many seeded deals and keeps, per hand class, the move with the best
+ * average finishing rank.
+ *
+ *   ./opening_book_gen <out.book> [--deals N] [--seed S] [--players P]
+ *                      [--rules file] [--threads T] [--min-samples M]
+ *
+ * Each candidate is replayed on the same deal with the same (deterministic
+ * greedy) opponents, so the comparison between moves is paired per deal.
+ */
+
+namespace {
+
+// Greedy play, except that the first own move is forced to `opening`
+class ProbeStrategy : public PlayerStrategy {
+public:
+    void initialize(uint64_t playerID) override { greedy.initialize(playerID); }
+    void onGameStart(const GameStartInfo& info) override {
+        greedy.initialize(info.seat);
+        pending = forced;
+    }
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override
+    {
+        if (pending) {
+            pending = false;
+            for (int i = 0; i < static_cast<int>(hand.size()); i++) {
+                if (hand[i].suit == opening.suit && hand[i].rank == opening.rank) return i;
+            }
+        }
+        return greedy.selectCardToPlay(hand, tableLayout);
+    }
+    void observeMove(uint64_t, const Card&) override {}
+    void observePass(uint64_t) override {}
+    bool wantsObservations() const override { return false; }
+    std::string getName() const override { return "ProbeStrategy"; }
+
+    bool forced = false;
+    Card opening{0, 0};
+
+private:
+    GreedyStrategy greedy;
+    bool pending = false;
+};
+
+struct MoveStats {
+    std::vector<double> rankSum = std::vector<double>(OpeningBook::kEntries * 8, 0.0);
+    std::vector<uint32_t> samples = std::vector<uint32_t>(OpeningBook::kEntries * 8, 0);
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const char* usage = "Usage: ./opening_book_gen <out.book> [--deals N] [--seed S] [--players P]"
+                        " [--rules file] [--threads T] [--min-samples M]\n";
+    if (argc >= 2 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
+        std::cout << usage;
+        return 0;
+    }
+    if (argc < 2 || std::string(argv[1]).rfind("--", 0) == 0) {
+        std::cerr << usage;
+        return 1;
+    }
+    const std::string outPath = argv[1];
+    std::string rulesPath;
+    uint64_t deals = 20000;
+    uint64_t seed = 0;
+    uint64_t numPlayers = 4;
+    uint32_t minSamples = 3;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--deals") deals = std::stoull(argv[++i]);
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else if (arg == "--threads") threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            else if (arg == "--min-samples") minSamples = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        GameRules rules;
+        {
+            MyGameMapper probe;
+            probe.read_game(rulesPath);
+            rules = probe.getRules();
+        }
+        rules.validate(numPlayers);
+        if (rules.numDecks != 1) {
+            throw std::invalid_argument("Opening books are built for a single deck");
+        }
+        // Suits whose opening card starts on the table; only their neighbours are book moves
+        const uint8_t openSuits = OpeningBook::openSuitsOf(rules);
+        if (openSuits == 0) {
+            throw std::invalid_argument("Opening books need an opening card on the table, and these rules start "
+                                        "with no open suit");
+        }
+        bool open[4];
+        for (int suit = 0; suit < 4; suit++) open[suit] = (openSuits >> suit) & 1;
+
+        OpeningBook book(rules.openRank, openSuits);
+        MoveStats total;
+        std::mutex totalMutex;
+        std::atomic<uint64_t> next{0};
+        std::atomic<uint64_t> games{0};
+        std::string error;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&]() {
+                try {
+                    MyGameMapper mapper;
+                    mapper.read_cards("");
+                    mapper.setRules(rules);
+                    std::vector<std::shared_ptr<ProbeStrategy>> seats;
+                    for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                        seats.push_back(std::make_shared<ProbeStrategy>());
+                        mapper.registerStrategy(seat, seats.back());
+                    }
+
+                    MoveStats local;
+                    uint64_t played = 0;
+                    std::array<int, 4> slotSuit;
+                    for (uint64_t d = next++; d < deals; d = next++) {
+                        const Deal deal = mapper.previewDeal(numPlayers, seed + d);
+                        for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                            const std::vector<Card>& hand = deal.hands[seat];
+                            const uint32_t handClass = book.classify(hand, slotSuit);
+
+                            std::vector<Card> candidates;
+                            for (const Card& card : hand) {
+                                if (open[card.suit] && (card.rank == rules.openRank - 1 ||
+                                                        card.rank == rules.openRank + 1)) {
+                                    candidates.push_back(card);
+                                }
+                            }
+                            if (candidates.size() < 2) continue;  // Nothing to decide
+
+                            for (const Card& candidate : candidates) {
+                                seats[seat]->forced = true;
+                                seats[seat]->opening = candidate;
+                                mapper.setDealSeed(seed + d);
+                                auto results = mapper.compute_game_progress(numPlayers);
+                                played++;
+
+                                int slot = 0;
+                                while (slotSuit[slot] != candidate.suit) slot++;
+                                const size_t key = static_cast<size_t>(handClass) * 8 +
+                                    OpeningBook::encodeMove(slot, candidate.rank > rules.openRank);
+                                for (const auto& result : results) {
+                                    if (result.first == seat) local.rankSum[key] += result.second;
+                                }
+                                local.samples[key]++;
+                            }
+                            seats[seat]->forced = false;
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(totalMutex);
+                    for (size_t i = 0; i < local.samples.size(); i++) {
+                        total.rankSum[i] += local.rankSum[i];
+                        total.samples[i] += local.samples[i];
+                    }
+                    games += played;
+                } catch (const std::exception& e) {
+                    std::lock_guard<std::mutex> lock(totalMutex);
+                    error = e.what();
+                    next = deals;
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        if (!error.empty()) throw std::runtime_error(error);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Keep the move with the lowest mean rank among sufficiently sampled ones
+        for (uint32_t handClass = 0; handClass < OpeningBook::kEntries; handClass++) {
+            double bestMean = 0.0;
+            uint8_t bestMove = OpeningBook::kNoMove;
+            for (uint8_t move = 0; move < 8; move++) {
+                const size_t key = static_cast<size_t>(handClass) * 8 + move;
+                if (total.samples[key] < minSamples) continue;
+                const double mean = total.rankSum[key] / total.samples[key];
+                if (bestMove == OpeningBook::kNoMove || mean < bestMean) {
+                    bestMean = mean;
+                    bestMove = move;
+                }
+            }
+            book.setEntry(handClass, bestMove);
+        }
+        book.save(outPath);
+
+        std::cout << "[opening_book_gen] " << games.load() << " games over " << deals << " deal(s) in "
+                  << seconds << " s\n";
+        std::cout << "[opening_book_gen] " << book.knownEntries() << " of " << OpeningBook::kEntries
+                  << " hand classes covered, wrote " << outPath << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[opening_book_gen] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "game/results/ResultsFile.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Scans results files written by batch_sim --results.
+ *
+ *   ./results_tool summary <file.results>
+ *       per-strategy win rate, average rank, cards left, passes and time per
+ *       decision, plus the distribution of game lengths
+ *   ./results_tool show <file.results> [first] [count]
+ *       the games as CSV, one line per game
+ *
+ * summary reads each column once, block by block, so it runs at disk speed
+ * without decoding whole games.
+ */
+
+static void printUsage() {
+    std::cout << "Usage:\n"
+              << "  ./results_tool summary <file.results>\n"
+              << "  ./results_tool show <file.results> [first] [count]\n";
+}
+
+static int summary(const ResultsFile& file) {
+    struct Totals {
+        uint64_t seats = 0;
+        uint64_t wins = 0;
+        uint64_t rankSum = 0;
+        uint64_t cardsLeft = 0;
+        uint64_t passes = 0;
+        uint64_t decisions = 0;
+        uint64_t decisionNanos = 0;
+    };
+    std::vector<Totals> totals(file.strategies().size());
+    std::vector<uint64_t> lengths;
+    uint64_t turnSum = 0;
+
+    for (size_t block = 0; block < file.blockCount(); block++) {
+        const uint64_t rows = file.blockRows(block);
+        const auto turns = file.column(block, ResultColumn::Turns);
+        for (uint64_t row = 0; row < rows; row++) {
+            const uint64_t length = turns[row];
+            if (lengths.size() <= length) lengths.resize(length + 1);
+            lengths[length]++;
+            turnSum += length;
+        }
+        for (uint64_t seat = 0; seat < file.numPlayers(); seat++) {
+            const auto strategy = file.column(block, ResultColumn::Strategy, seat);
+            const auto rank = file.column(block, ResultColumn::Rank, seat);
+            const auto cardsLeft = file.column(block, ResultColumn::CardsLeft, seat);
+            const auto passes = file.column(block, ResultColumn::Passes, seat);
+            const auto decisions = file.column(block, ResultColumn::Decisions, seat);
+            const auto nanos = file.column(block, ResultColumn::DecisionNanos, seat);
+            for (uint64_t row = 0; row < rows; row++) {
+                Totals& t = totals.at(strategy[row]);
+                t.seats++;
+                t.wins += rank[row] == 1;
+                t.rankSum += rank[row];
+                t.cardsLeft += cardsLeft[row];
+                t.passes += passes[row];
+                t.decisions += decisions[row];
+                t.decisionNanos += nanos[row];
+            }
+        }
+    }
+
+    std::cout << file.size() << " games, " << file.numPlayers() << " players"
+              << (file.truncated() ? " (last block incomplete, ignored)" : "") << "\n\n";
+    std::cout << std::left << std::setw(24) << "strategy" << std::right << std::setw(12) << "seats"
+              << std::setw(10) << "win rate" << std::setw(10) << "avg rank" << std::setw(12) << "cards left"
+              << std::setw(10) << "passes" << std::setw(12) << "us/decision" << "\n";
+    std::cout << std::fixed << std::setprecision(4);
+    for (size_t i = 0; i < totals.size(); i++) {
+        const Totals& t = totals[i];
+        if (t.seats == 0) continue;
+        const double n = static_cast<double>(t.seats);
+        std::cout << std::left << std::setw(24) << file.strategies()[i] << std::right << std::setw(12) << t.seats
+                  << std::setw(10) << t.wins / n << std::setw(10) << t.rankSum / n << std::setw(12)
+                  << t.cardsLeft / n << std::setw(10) << t.passes / n << std::setw(12)
+                  << (t.decisions ? t.decisionNanos / 1000.0 / t.decisions : 0.0) << "\n";
+    }
+
+    if (file.size() > 0) {
+        std::cout << "\nCards played per game: mean " << static_cast<double>(turnSum) / file.size() << "\n";
+        std::cout << std::defaultfloat;
+        for (size_t length = 0; length < lengths.size(); length++) {
+            if (lengths[length] == 0) continue;
+            std::cout << std::setw(6) << length << "  " << lengths[length] << "\n";
+        }
+    }
+    return 0;
+}
+
+static int show(const ResultsFile& file, uint64_t first, uint64_t count) {
+    std::cout << "game,seed,turns,rounds";
+    for (uint64_t seat = 0; seat < file.numPlayers(); seat++) {
+        std::cout << ",strategy" << seat << ",rank" << seat << ",cards_left" << seat << ",passes" << seat
+                  << ",decisions" << seat << ",decision_ns" << seat;
+    }
+    std::cout << "\n";
+
+    GameRecord game;
+    // first + count may wrap for large counts
+    const uint64_t end = first >= file.size() ? first : first + std::min(count, file.size() - first);
+    for (uint64_t index = first; index < end; index++) {
+        file.get(index, game);
+        std::cout << index << "," << game.seed << "," << game.turns << "," << game.rounds;
+        for (const SeatResult& seat : game.seats) {
+            std::cout << "," << file.strategies().at(seat.strategy) << "," << seat.rank << "," << seat.cardsLeft
+                      << "," << seat.passes << "," << seat.decisions << "," << seat.decisionNanos;
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    const std::string command = argv[1];
+
+    try {
+        ResultsFile file(argv[2]);
+        if (command == "summary") return summary(file);
+        if (command == "show") {
+            const uint64_t first = (argc > 3) ? std::stoull(argv[3]) : 0;
+            const uint64_t count = (argc > 4) ? std::stoull(argv[4]) : file.size();
+            return show(file, first, count);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[results_tool] " << e.what() << "\n";
+        return 1;
+    }
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,310 @@
+#include "strat/RLStrategy.hpp"
+#include "strat/RandomStrategy.hpp"
+#include "game/mapper/MyGameMapper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Hyperparameter sweep for RLStrategy: trains one agent per grid point,
+ * several trials at a time, and writes a CSV row per trial.
+ *
+ *   ./rl_sweep <sweep.spec> [--out results.csv] [--base rl.cfg] [--threads T]
+ *              [--episodes N] [--eval-every N] [--warmup K] [--min-reports M]
+ *              [--players P] [--rules file]
+ *
+ * The spec lists RLConfig keys with comma-separated candidates, e.g.
+ *   epsilon = 0.1, 0.3
+ *   epsilon_decay = constant, linear
+ *   alpha = 0.05, 0.1, 0.2
+ * and the grid is their cartesian product on top of --base. Every trial
+ * trains against random opponents on the same sequence of deals.
+ *
+ * Pruning uses the median rule: every --eval-every episodes a trial reports
+ * its win rate over that window; from the --warmup'th report on, a trial
+ * below the median of at least --min-reports other trials at the same point
+ * stops early.
+ */
+
+namespace {
+
+struct Trial {
+    RLConfig config;
+    std::vector<std::string> values;  // One per swept key
+    std::string status = "pending";
+    uint64_t episodes = 0;
+    double winRate = 0.0;      // Last reported window
+    double bestWinRate = 0.0;
+};
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    size_t last = text.find_last_not_of(" \t\r");
+    return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+}
+
+// Swept keys and their candidate values, in file order
+std::vector<std::pair<std::string, std::vector<std::string>>> readSpec(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open sweep spec: " + path);
+    }
+    std::vector<std::pair<std::string, std::vector<std::string>>> keys;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            if (!trim(line).empty()) {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": expected key = v1, v2, ...");
+            }
+            continue;
+        }
+        std::vector<std::string> values;
+        std::stringstream list(line.substr(eq + 1));
+        std::string value;
+        while (std::getline(list, value, ',')) {
+            if (!trim(value).empty()) values.push_back(trim(value));
+        }
+        if (values.empty()) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": no values");
+        }
+        keys.emplace_back(trim(line.substr(0, eq)), values);
+    }
+    return keys;
+}
+
+// Median-rule bookkeeping shared by all trials
+class Pruner {
+public:
+    Pruner(uint64_t warmup, uint64_t minReports) : warmup(warmup), min_reports(minReports) {}
+
+    // Record a report; returns true if the trial should stop
+    bool report(uint64_t rung, double winRate) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (reports.size() <= rung) reports.resize(rung + 1);
+        std::vector<double>& others = reports[rung];
+        bool prune = false;
+        if (rung + 1 >= warmup && !others.empty() && others.size() >= min_reports) {
+            std::vector<double> sorted = others;
+            std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+            prune = winRate < sorted[sorted.size() / 2];
+        }
+        others.push_back(winRate);
+        return prune;
+    }
+
+private:
+    uint64_t warmup;
+    uint64_t min_reports;
+    std::mutex mutex;
+    std::vector<std::vector<double>> reports;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <sweep.spec> [--out results.csv] [--base rl.cfg] [--threads T]"
+                  << " [--episodes N] [--eval-every N] [--warmup K] [--min-reports M] [--players P]"
+                  << " [--rules file]\n";
+        return 1;
+    }
+    std::string specPath = argv[1];
+    std::string outPath = "sweep_results.csv";
+    std::string basePath;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t episodes = 200000;
+    uint64_t evalEvery = 20000;
+    uint64_t warmup = 2;
+    uint64_t minReports = 3;
+    uint64_t numPlayers = 4;
+    std::string rulesPath;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--out") outPath = argv[++i];
+            else if (arg == "--base") basePath = argv[++i];
+            else if (arg == "--threads") threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            else if (arg == "--episodes") episodes = std::stoull(argv[++i]);
+            else if (arg == "--eval-every") evalEvery = std::stoull(argv[++i]);
+            else if (arg == "--warmup") warmup = std::stoull(argv[++i]);
+            else if (arg == "--min-reports") minReports = std::stoull(argv[++i]);
+            else if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        if (threads == 0) threads = 1;
+        if (evalEvery == 0) evalEvery = episodes;
+        const RLConfig base = basePath.empty() ? RLConfig() : RLConfig::load(basePath);
+        const auto keys = readSpec(specPath);
+
+        // Expand the grid (last key varies fastest)
+        std::vector<Trial> trials(1);
+        trials[0].config = base;
+        for (const auto& key : keys) {
+            std::vector<Trial> expanded;
+            for (const Trial& trial : trials) {
+                for (const std::string& value : key.second) {
+                    Trial next = trial;
+                    try {
+                        next.config.set(key.first, value);
+                    } catch (const std::invalid_argument& e) {
+                        throw std::runtime_error(specPath + ": " + e.what());
+                    }
+                    next.values.push_back(value);
+                    expanded.push_back(std::move(next));
+                }
+            }
+            trials.swap(expanded);
+        }
+        for (size_t t = 0; t < trials.size(); t++) {
+            trials[t].config.validate();
+            if (trials[t].config.seed == 0) trials[t].config.seed = t + 1;
+        }
+
+        MyGameMapper prototype;
+        prototype.read_cards("");
+        prototype.read_game(rulesPath);
+        prototype.getRules().validate(numPlayers);
+
+        std::cout << "Sweeping " << trials.size() << " trials of " << episodes << " episodes on "
+                  << threads << " threads" << std::endl;
+
+        Pruner pruner(warmup, minReports);
+        std::atomic<size_t> next{0};
+        std::mutex print_mutex;
+
+        auto trainTrial = [&](Trial& trial) {
+            MyGameMapper mapper = prototype;
+            auto agent = std::make_shared<RLStrategy>(trial.config);
+            mapper.registerStrategy(0, agent);
+            for (uint64_t seat = 1; seat < numPlayers; seat++) {
+                mapper.registerStrategy(seat, std::make_shared<RandomStrategy>());
+            }
+
+            uint64_t windowWins = 0;
+            trial.status = "done";
+            for (uint64_t episode = 1; episode <= episodes; episode++) {
+                mapper.setDealSeed(0xC0FFEE00000ULL + episode);
+                for (const auto& result : mapper.compute_game_progress(numPlayers)) {
+                    if (result.first == 0 && result.second == 1) windowWins++;
+                }
+                trial.episodes = episode;
+
+                if (episode % evalEvery == 0 || episode == episodes) {
+                    const uint64_t window = episode % evalEvery == 0 ? evalEvery : episode % evalEvery;
+                    trial.winRate = static_cast<double>(windowWins) / window;
+                    trial.bestWinRate = std::max(trial.bestWinRate, trial.winRate);
+                    windowWins = 0;
+                    if (episode < episodes && pruner.report(episode / evalEvery - 1, trial.winRate)) {
+                        trial.status = "pruned";
+                        break;
+                    }
+                }
+            }
+        };
+
+        // Exceptions must not escape a worker thread; a trial that throws is
+        // reported as failed and the sweep goes on
+        auto runTrial = [&](Trial& trial, size_t index) {
+            std::string error;
+            try {
+                trainTrial(trial);
+            } catch (const std::exception& e) {
+                trial.status = "failed";
+                error = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(print_mutex);
+            if (!error.empty()) {
+                std::cerr << "[rl_sweep] Trial " << index << " failed after " << trial.episodes
+                          << " episodes: " << error << std::endl;
+                return;
+            }
+            std::cout << "Trial " << index << " " << trial.status << " after " << trial.episodes
+                      << " episodes, win rate " << trial.winRate << std::endl;
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&]() {
+                for (size_t index = next++; index < trials.size(); index = next++) {
+                    runTrial(trials[index], index);
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        std::ofstream out(outPath);
+        if (!out) {
+            throw std::runtime_error("Could not create results file: " + outPath);
+        }
+        out << "trial";
+        for (const auto& key : keys) out << "," << key.first;
+        out << ",status,episodes,win_rate,best_win_rate\n";
+        for (size_t t = 0; t < trials.size(); t++) {
+            out << t;
+            for (const std::string& value : trials[t].values) out << "," << value;
+            out << "," << trials[t].status << "," << trials[t].episodes << ","
+                << trials[t].winRate << "," << trials[t].bestWinRate << "\n";
+        }
+        out.close();
+        if (out.fail()) {
+            throw std::runtime_error("Failed to write results file: " + outPath);
+        }
+
+        // Leaderboard of finished trials
+        std::vector<size_t> order;
+        size_t failed = 0;
+        for (size_t t = 0; t < trials.size(); t++) {
+            if (trials[t].status == "done") order.push_back(t);
+            if (trials[t].status == "failed") failed++;
+        }
+        std::sort(order.begin(), order.end(),
+                  [&](size_t a, size_t b) { return trials[a].winRate > trials[b].winRate; });
+        std::cout << "\n=== Best trials (" << order.size() << " finished, "
+                  << trials.size() - order.size() - failed << " pruned, " << failed << " failed) ===\n";
+        for (size_t k = 0; k < order.size() && k < 5; k++) {
+            const Trial& trial = trials[order[k]];
+            std::cout << "Trial " << order[k] << ": win rate " << std::fixed << std::setprecision(4)
+                      << trial.winRate << std::defaultfloat;
+            for (size_t i = 0; i < keys.size(); i++) std::cout << ", " << keys[i].first << "=" << trial.values[i];
+            std::cout << "\n";
+        }
+        std::cout << "Results written to " << outPath << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[rl_sweep] " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "ActorCritic.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace sevens {
+
+namespace {
+
+// into += from, then from = 0
+void drain(std::vector<float>& into, std::vector<float>& from) {
+    for (size_t i = 0; i < into.size(); i++) {
+        into[i] += from[i];
+        from[i] = 0.0f;
+    }
+}
+
+} // namespace
+
+ActorCriticUpdater::ActorCriticUpdater(const ActorCriticConfig& config) : config(config) {
+    if (this->config.threads == 0) this->config.threads = 1;
+}
+
+void ActorCriticUpdater::estimate(const std::vector<PolicyEpisode>& episodes) {
+    steps.clear();
+    advantages.clear();
+    targets.clear();
+    const float decay = config.gamma * config.lambda;
+
+    for (const PolicyEpisode& episode : episodes) {
+        const size_t first = steps.size();
+        const size_t count = episode.steps.size();
+        for (const PolicyStep& step : episode.steps) steps.push_back(&step);
+        advantages.resize(first + count);
+        targets.resize(first + count);
+
+        // Backwards over the episode: delta_t = r_t + gamma * V_{t+1} - V_t,
+        // with r = 0 except the final return and V = 0 after the last step
+        float next_value = 0.0f;
+        float reward = episode.ret;
+        float gae = 0.0f;
+        for (size_t k = count; k-- > 0;) {
+            const float value = episode.steps[k].value;
+            const float delta = reward + config.gamma * next_value - value;
+            gae = delta + decay * gae;
+            advantages[first + k] = gae;
+            targets[first + k] = gae + value;
+            next_value = value;
+            reward = 0.0f;
+        }
+    }
+
+    // Normalize advantages across the whole batch
+    if (advantages.size() < 2) return;
+    double mean = 0.0, square = 0.0;
+    for (float a : advantages) {
+        mean += a;
+        square += static_cast<double>(a) * a;
+    }
+    mean /= advantages.size();
+    const double stddev = std::sqrt(std::max(square / advantages.size() - mean * mean, 1e-8));
+    for (float& a : advantages) a = static_cast<float>((a - mean) / stddev);
+}
+
+void ActorCriticUpdater::accumulate(const PolicyValueNet& net, size_t begin, size_t end,
+                                    PolicyValueNet::Gradients& grads, ActorCriticStats& stats) const {
+    PolicyValueNet::Activations act;
+    alignas(32) std::array<float, PolicyValueNet::kOutputs> dOutput;
+    std::array<float, 52> prob;
+
+    for (size_t i = begin; i < end; i++) {
+        const PolicyStep& step = *steps[i];
+        net.forward(step.features.data(), act);
+        const float* logits = act.output.data();
+
+        // Softmax over the legal cards
+        float maxLogit = -INFINITY;
+        for (uint64_t legal = step.legal; legal; legal &= legal - 1) {
+            maxLogit = std::max(maxLogit, logits[__builtin_ctzll(legal)]);
+        }
+        float total = 0.0f;
+        for (uint64_t legal = step.legal; legal; legal &= legal - 1) {
+            const int id = __builtin_ctzll(legal);
+            prob[id] = std::exp(logits[id] - maxLogit);
+            total += prob[id];
+        }
+        float entropy = 0.0f;
+        for (uint64_t legal = step.legal; legal; legal &= legal - 1) {
+            const int id = __builtin_ctzll(legal);
+            prob[id] /= total;
+            if (prob[id] > 0.0f) entropy -= prob[id] * std::log(prob[id]);
+        }
+
+        // Policy and entropy gradients w.r.t. the logits; dH/dz_i = -p_i (log p_i + H)
+        dOutput.fill(0.0f);
+        const float advantage = advantages[i];
+        for (uint64_t legal = step.legal; legal; legal &= legal - 1) {
+            const int id = __builtin_ctzll(legal);
+            const float logp = prob[id] > 0.0f ? std::log(prob[id]) : 0.0f;
+            dOutput[id] = advantage * (prob[id] - (id == step.action ? 1.0f : 0.0f)) +
+                          config.entropyCoef * prob[id] * (logp + entropy);
+        }
+        const float value = logits[PolicyValueNet::kValue];
+        const float error = value - targets[i];
+        dOutput[PolicyValueNet::kValue] = config.valueCoef * error;
+
+        net.backward(step.features.data(), act, dOutput.data(), grads);
+        stats.valueLoss += 0.5 * error * error;
+        stats.entropy += entropy;
+        stats.steps++;
+    }
+}
+
+ActorCriticStats ActorCriticUpdater::update(PolicyValueNet& net, const std::vector<PolicyEpisode>& episodes) {
+    estimate(episodes);
+    ActorCriticStats total;
+    if (steps.empty()) return total;
+
+    const unsigned threads = static_cast<unsigned>(std::min<size_t>(config.threads, steps.size()));
+    while (worker_grads.size() < threads) worker_grads.push_back(net.makeGradients());
+    std::vector<ActorCriticStats> worker_stats(threads);
+
+    // Backward passes in parallel; the net is only read until every worker is done
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        const size_t begin = steps.size() * t / threads;
+        const size_t end = steps.size() * (t + 1) / threads;
+        workers.emplace_back([this, &net, &worker_stats, t, begin, end]() {
+            accumulate(net, begin, end, worker_grads[t], worker_stats[t]);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    PolicyValueNet::Gradients& sum = worker_grads[0];
+    for (unsigned t = 1; t < threads; t++) {
+        PolicyValueNet::Gradients& part = worker_grads[t];
+        drain(sum.w1, part.w1);
+        drain(sum.b1, part.b1);
+        drain(sum.w2, part.w2);
+        drain(sum.b2, part.b2);
+        drain(sum.w3, part.w3);
+        drain(sum.b3, part.b3);
+        sum.samples += part.samples;
+        part.samples = 0;
+    }
+    net.apply(sum, config.learningRate);
+
+    for (const ActorCriticStats& stats : worker_stats) {
+        total.steps += stats.steps;
+        total.valueLoss += stats.valueLoss;
+        total.entropy += stats.entropy;
+    }
+    total.valueLoss /= total.steps;
+    total.entropy /= total.steps;
+    return total;
+}
+
+} // namespace sevens
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "NeuralNet.hpp"
+#include "NeuralStrategy.hpp"
+#include <vector>
+
+namespace sevens {
+
+struct ActorCriticConfig {
+    float learningRate = 0.05f;
+    float gamma = 1.0f;         // Discount per decision
+    float lambda = 0.95f;       // GAE trace decay
+    float valueCoef = 0.5f;     // Weight of the value loss
+    float entropyCoef = 0.01f;  // Weight of the entropy bonus
+    unsigned threads = 1;
+};
+
+// Averages over the steps of one update
+struct ActorCriticStats {
+    uint64_t steps = 0;
+    double valueLoss = 0.0;
+    double entropy = 0.0;
+};
+
+/**
+ * Synchronous advantage actor-critic update for PolicyValueNet.
+ *
+ * For a batch of episodes it computes generalized advantage estimates from
+ * the values recorded while playing (the only reward is the final return),
+ * normalizes them across the batch, and takes one SGD step on
+ *   -A * log pi(a) + valueCoef * (V - target)^2 / 2 - entropyCoef * H(pi)
+ * with the softmax restricted to the legal cards. The backward passes are
+ * split over `threads` workers, each with its own gradient buffer, and the
+ * buffers are summed before the step.
+ */
+class ActorCriticUpdater {
+public:
+    explicit ActorCriticUpdater(const ActorCriticConfig& config);
+
+    ActorCriticStats update(PolicyValueNet& net, const std::vector<PolicyEpisode>& episodes);
+
+    const ActorCriticConfig& getConfig() const { return config; }
+
+private:
+    ActorCriticConfig config;
+    std::vector<PolicyValueNet::Gradients> worker_grads;
+
+    // Flattened batch: every step with its advantage and value target
+    std::vector<const PolicyStep*> steps;
+    std::vector<float> advantages;
+    std::vector<float> targets;
+
+    void estimate(const std::vector<PolicyEpisode>& episodes);
+    void accumulate(const PolicyValueNet& net, size_t begin, size_t end,
+                    PolicyValueNet::Gradients& grads, ActorCriticStats& stats) const;
+};
+
+} // namespace sevens
@@ -0,0 +1,298 @@
+#include "Checkpoint.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace sevens {
+
+namespace {
+
+uint64_t fnv1a(const char* data, size_t size) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+void putInt(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+std::runtime_error systemError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+void writeAll(int fd, const std::string& bytes, const std::string& path) {
+    size_t done = 0;
+    while (done < bytes.size()) {
+        ssize_t n = ::write(fd, bytes.data() + done, bytes.size() - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("Failed to write", path);
+        }
+        done += static_cast<size_t>(n);
+    }
+}
+
+// Checkpoint files with this prefix and their steps, oldest first. Steps are
+// zero-padded to at least 12 digits (see pathFor), so longer names are
+// ordered by step.
+std::vector<std::pair<uint64_t, std::string>> listCheckpoints(const std::string& directory,
+                                                              const std::string& prefix) {
+    std::vector<std::pair<uint64_t, std::string>> found;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() < prefix.size() + 18 || name.compare(0, prefix.size() + 1, prefix + "-") != 0 ||
+            name.compare(name.size() - 5, 5, ".ckpt") != 0) {
+            continue;
+        }
+        const std::string digits = name.substr(prefix.size() + 1, name.size() - prefix.size() - 6);
+        if (digits.size() > 20 || digits.find_first_not_of("0123456789") != std::string::npos) continue;
+        try {
+            found.emplace_back(std::stoull(digits), entry.path().string());
+        } catch (const std::out_of_range&) {
+            // Not a step this writer could have produced
+        }
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+} // namespace
+
+const std::string& Checkpoint::get(const std::string& name) const {
+    auto it = sections.find(name);
+    if (it == sections.end()) {
+        throw std::runtime_error("Checkpoint has no '" + name + "' section");
+    }
+    return it->second;
+}
+
+std::string Checkpoint::encode() const {
+    std::string out(kMagic, 4);
+    putInt(out, kVersion, 2);
+    putInt(out, sections.size(), 2);
+    for (const auto& section : sections) {
+        putInt(out, section.first.size(), 2);
+        out += section.first;
+        putInt(out, section.second.size(), 8);
+        out += section.second;
+    }
+    putInt(out, fnv1a(out.data(), out.size()), 8);
+    return out;
+}
+
+Checkpoint Checkpoint::decode(const std::string& bytes, const std::string& source) {
+    auto fail = [&source](const std::string& why) {
+        return std::runtime_error("Corrupt checkpoint " + source + ": " + why);
+    };
+    if (bytes.size() < 16 || std::memcmp(bytes.data(), kMagic, 4) != 0) {
+        throw fail("bad header");
+    }
+    const size_t body = bytes.size() - 8;
+    size_t pos = 4;
+    auto getInt = [&](int width) {
+        if (pos + width > body) throw fail("truncated");
+        uint64_t value = 0;
+        for (int i = 0; i < width; i++) value |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[pos + i])) << (8 * i);
+        pos += width;
+        return value;
+    };
+
+    uint64_t stored = 0;
+    for (int i = 0; i < 8; i++) stored |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[body + i])) << (8 * i);
+    if (stored != fnv1a(bytes.data(), body)) {
+        throw fail("checksum mismatch");
+    }
+    if (getInt(2) != kVersion) {
+        throw fail("unsupported version");
+    }
+
+    Checkpoint checkpoint;
+    const uint64_t count = getInt(2);
+    for (uint64_t s = 0; s < count; s++) {
+        const uint64_t nameSize = getInt(2);
+        if (pos + nameSize > body) throw fail("truncated");
+        std::string name = bytes.substr(pos, nameSize);
+        pos += nameSize;
+        const uint64_t size = getInt(8);
+        if (size > body - pos) throw fail("truncated");
+        checkpoint.sections[name] = bytes.substr(pos, size);
+        pos += size;
+    }
+    if (pos != body) {
+        throw fail("trailing bytes");
+    }
+    return checkpoint;
+}
+
+void Checkpoint::writeAtomic(const std::string& path) const {
+    const std::string bytes = encode();
+    const std::string temp = path + ".tmp." + std::to_string(::getpid());
+
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw systemError("Could not create", temp);
+    }
+    try {
+        writeAll(fd, bytes, temp);
+        if (::fsync(fd) != 0) throw systemError("Failed to sync", temp);
+    } catch (...) {
+        ::close(fd);
+        ::unlink(temp.c_str());
+        throw;
+    }
+    if (::close(fd) != 0) {
+        ::unlink(temp.c_str());
+        throw systemError("Failed to close", temp);
+    }
+    if (::rename(temp.c_str(), path.c_str()) != 0) {
+        ::unlink(temp.c_str());
+        throw systemError("Failed to rename onto", path);
+    }
+
+    // Make the rename itself durable
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    if (directory.empty()) directory = ".";
+    int dirfd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirfd >= 0) {
+        ::fsync(dirfd);
+        ::close(dirfd);
+    }
+}
+
+Checkpoint Checkpoint::read(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Could not open checkpoint: " + path);
+    }
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(bytes, path);
+}
+
+bool Checkpoint::looksLike(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4];
+    return file.read(magic, 4) && std::memcmp(magic, kMagic, 4) == 0;
+}
+
+CheckpointWriter::CheckpointWriter(std::string directory, std::string prefix, size_t keep)
+    : directory(std::move(directory)), prefix(std::move(prefix)), keep(std::max<size_t>(keep, 1))
+{
+    std::filesystem::create_directories(this->directory);
+    worker = std::thread(&CheckpointWriter::run, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this]() { return !pending && !busy; });
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void CheckpointWriter::submit(uint64_t step, Checkpoint checkpoint) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+        if (pending) skipped_count++;
+        pending = std::make_unique<Checkpoint>(std::move(checkpoint));
+        pending_step = step;
+    }
+    wake.notify_one();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return !pending && !busy; });
+    if (error) std::rethrow_exception(std::exchange(error, nullptr));
+}
+
+uint64_t CheckpointWriter::written() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return written_count;
+}
+
+uint64_t CheckpointWriter::skipped() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return skipped_count;
+}
+
+std::string CheckpointWriter::pathFor(uint64_t step) const {
+    std::string digits = std::to_string(step);
+    if (digits.size() < 12) digits.insert(0, 12 - digits.size(), '0');
+    return (std::filesystem::path(directory) / (prefix + "-" + digits + ".ckpt")).string();
+}
+
+void CheckpointWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return pending || stopping; });
+        if (!pending) return;
+
+        std::unique_ptr<Checkpoint> job = std::move(pending);
+        const uint64_t step = pending_step;
+        busy = true;
+        lock.unlock();
+
+        std::exception_ptr failure;
+        try {
+            job->writeAtomic(pathFor(step));
+            prune(step);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+
+        lock.lock();
+        busy = false;
+        if (failure) {
+            error = failure;
+        } else {
+            written_count++;
+        }
+        if (!pending) idle.notify_all();
+    }
+}
+
+void CheckpointWriter::prune(uint64_t newest) const {
+    // Later steps belong to another run sharing the directory (e.g. a fresh
+    // start over an old one); counting them would delete this run's files
+    std::vector<std::pair<uint64_t, std::string>> found = listCheckpoints(directory, prefix);
+    found.erase(std::upper_bound(found.begin(), found.end(), newest,
+                                 [](uint64_t step, const auto& entry) { return step < entry.first; }),
+                found.end());
+    for (size_t i = 0; i + keep < found.size(); i++) {
+        std::error_code ec;
+        std::filesystem::remove(found[i].second, ec);
+    }
+}
+
+std::string CheckpointWriter::findLatest(const std::string& directory, const std::string& prefix) {
+    std::vector<std::pair<uint64_t, std::string>> found = listCheckpoints(directory, prefix);
+    for (auto it = found.rbegin(); it != found.rend(); ++it) {
+        try {
+            Checkpoint::read(it->second);
+            return it->second;
+        } catch (const std::runtime_error&) {
+            // Torn or corrupt: fall back to the previous one
+        }
+    }
+    return "";
+}
+
+} // namespace sevens
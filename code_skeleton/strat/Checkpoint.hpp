@@ -0,0 +1,99 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace sevens {
+
+/**
+ * Named binary sections saved and loaded as one unit (model, RNG state,
+ * trainer counters...).
+ *
+ * File layout (little-endian): magic "SVCK", version:u16, sections:u16, then
+ * per section name length:u16, name, size:u64, bytes; finally the 64-bit
+ * FNV-1a hash of everything before it. read() rejects files with a bad
+ * header, a short body or a hash mismatch, so a torn write is never loaded.
+ */
+class Checkpoint {
+public:
+    static constexpr char kMagic[4] = {'S', 'V', 'C', 'K'};
+    static constexpr uint16_t kVersion = 1;
+
+    void put(const std::string& name, std::string bytes) { sections[name] = std::move(bytes); }
+    bool has(const std::string& name) const { return sections.count(name) != 0; }
+    // Throws std::runtime_error if the section is missing
+    const std::string& get(const std::string& name) const;
+
+    std::string encode() const;
+    // `source` names the data in error messages
+    static Checkpoint decode(const std::string& bytes, const std::string& source);
+
+    // Write to a temporary file next to path, fsync it, rename it over path
+    // and fsync the directory: readers see the old file or the new one.
+    void writeAtomic(const std::string& path) const;
+    static Checkpoint read(const std::string& path);
+
+    // Whether the file starts with the checkpoint magic
+    static bool looksLike(const std::string& path);
+
+private:
+    std::map<std::string, std::string> sections;
+};
+
+/**
+ * Writes checkpoints on a background thread so the training loop never
+ * waits for the disk.
+ *
+ * Files are <directory>/<prefix>-<step>.ckpt (step zero-padded to 12
+ * digits); after each write only the newest `keep` up to the step just
+ * written are kept, and files of later steps are left alone. If the
+ * writer falls behind, a newer submission replaces the one still waiting.
+ * A write error is rethrown by the next submit() or flush().
+ */
+class CheckpointWriter {
+public:
+    CheckpointWriter(std::string directory, std::string prefix, size_t keep);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(uint64_t step, Checkpoint checkpoint);
+    // Block until everything submitted so far is on disk
+    void flush();
+
+    uint64_t written() const;
+    uint64_t skipped() const;
+
+    // Newest checkpoint in directory that reads back cleanly ("" if none)
+    static std::string findLatest(const std::string& directory, const std::string& prefix);
+
+private:
+    std::string directory;
+    std::string prefix;
+    size_t keep;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::unique_ptr<Checkpoint> pending;
+    uint64_t pending_step = 0;
+    bool busy = false;
+    bool stopping = false;
+    uint64_t written_count = 0;
+    uint64_t skipped_count = 0;
+    std::exception_ptr error;
+    std::thread worker;
+
+    void run();
+    void prune(uint64_t newest) const;
+    std::string pathFor(uint64_t step) const;
+};
+
+} // namespace sevens
@@ -18,6 +18,7 @@ public:
         const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override;
     void observeMove(uint64_t playerID, const Card& playedCard) override;
     void observePass(uint64_t playerID) override;
+    bool wantsObservations() const override;
     std::string getName() const override;
     
 private:
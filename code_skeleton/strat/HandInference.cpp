@@ -0,0 +1,246 @@
+#include "HandInference.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace sevens {
+
+namespace {
+
+inline int popcount64(uint64_t mask) {
+    return __builtin_popcountll(mask);
+}
+
+} // namespace
+
+HandInference::HandInference(const GameRules& rules)
+    : layout(StateRules::compile(rules)), move_gen(MoveGenerator::compile(rules)) {}
+
+void HandInference::reset(const GameStartInfo& info) {
+    if (info.numPlayers > kMaxPlayers) {
+        throw std::invalid_argument("HandInference supports at most 8 players");
+    }
+    my_seat = info.seat;
+    num_players = info.numPlayers;
+    num_decks = info.numDecks;
+
+    mine.fill(0);
+    on_table.fill(0);
+    for (const Card& card : info.hand) mine[cardId(card)]++;
+    for (const Card& card : info.tableCards) on_table[cardId(card)]++;
+
+    uint64_t unseen_mask = 0;
+    for (int id = 0; id < kCards; id++) {
+        hidden[id] = static_cast<uint8_t>(num_decks - mine[id] - on_table[id]);
+        if (hidden[id] > 0) unseen_mask |= (1ULL << id);
+    }
+
+    possible.fill(0);
+    hand_count.fill(0);
+    for (uint64_t p = 0; p < num_players; p++) {
+        hand_count[p] = static_cast<uint32_t>(p < info.handSizes.size() ? info.handSizes[p] : 0);
+        if (p == my_seat) {
+            for (int id = 0; id < kCards; id++) {
+                if (mine[id] > 0) possible[p] |= (1ULL << id);
+            }
+        } else if (hand_count[p] > 0) {
+            possible[p] = unseen_mask;
+        }
+    }
+}
+
+void HandInference::onMove(uint64_t playerID, const Card& card) {
+    int id = cardId(card);
+    on_table[id]++;
+    if (hand_count[playerID] > 0) hand_count[playerID]--;
+
+    if (playerID == my_seat) {
+        if (mine[id] > 0 && --mine[id] == 0) possible[playerID] &= ~(1ULL << id);
+        return;
+    }
+
+    if (hidden[id] > 0) hidden[id]--;
+    removeIfExhausted(id);
+    if (hand_count[playerID] == 0) possible[playerID] = 0;
+}
+
+void HandInference::onPass(uint64_t playerID) {
+    if (playerID == my_seat) return;
+    // A pass is only legal when none of the playable cards is in hand
+    possible[playerID] &= ~playableMask();
+}
+
+void HandInference::removeIfExhausted(int id) {
+    if (hidden[id] != 0) return;
+    uint64_t keep = ~(1ULL << id);
+    for (uint64_t p = 0; p < num_players; p++) {
+        if (p != my_seat) possible[p] &= keep;
+    }
+}
+
+uint64_t HandInference::playableMask() const {
+    if (num_decks == 1) {
+        uint64_t table = 0;
+        for (int id = 0; id < kCards; id++) {
+            if (on_table[id]) table |= (1ULL << id);
+        }
+        return layout.playable(table);
+    }
+
+    TableCounts counts{};
+    for (int id = 0; id < kCards; id++) {
+        const PackedCard card(static_cast<uint8_t>(id));
+        counts[card.suit()][card.rank()] = on_table[id];
+    }
+    uint64_t mask = 0;
+    for (int id = 0; id < kCards; id++) {
+        if (move_gen.isPlayable(counts, cardFromId(id))) mask |= (1ULL << id);
+    }
+    return mask;
+}
+
+double HandInference::probability(uint64_t playerID, const Card& card) const {
+    const int id = cardId(card);
+    if (playerID == my_seat) return mine[id] > 0 ? 1.0 : 0.0;
+    if (!(possible[playerID] >> id & 1ULL)) return 0.0;
+
+    // Each seat's share is weighted by how densely it must fill its possible set
+    double total = 0.0;
+    double own = 0.0;
+    for (uint64_t p = 0; p < num_players; p++) {
+        if (p == my_seat || !(possible[p] >> id & 1ULL)) continue;
+        double weight = static_cast<double>(hand_count[p]) / popcount64(possible[p]);
+        total += weight;
+        if (p == playerID) own = weight;
+    }
+    if (total <= 0.0) return 0.0;
+
+    double share = own / total;
+    if (hidden[id] <= 1) return share;
+    double none = 1.0;
+    for (int copy = 0; copy < hidden[id]; copy++) none *= (1.0 - share);
+    return 1.0 - none;
+}
+
+void HandInference::probabilities(std::vector<double>& probs) const {
+    probs.assign(num_players * kCards, 0.0);
+    for (uint64_t p = 0; p < num_players; p++) {
+        uint64_t mask = possible[p];
+        while (mask) {
+            int id = __builtin_ctzll(mask);
+            mask &= mask - 1;
+            probs[p * kCards + id] = probability(p, cardFromId(id));
+        }
+    }
+}
+
+bool HandInference::sampleDeal(std::mt19937_64& rng, std::vector<std::vector<Card>>& hands) const {
+    // Hidden copies still to place, most constrained first
+    std::vector<int> copies;
+    copies.reserve(kCards * num_decks);
+    for (int id = 0; id < kCards; id++) {
+        for (int c = 0; c < hidden[id]; c++) copies.push_back(id);
+    }
+
+    std::array<int, kCards> holders{};
+    for (int id = 0; id < kCards; id++) {
+        for (uint64_t p = 0; p < num_players; p++) {
+            if (p != my_seat && (possible[p] >> id & 1ULL)) holders[id]++;
+        }
+    }
+    std::shuffle(copies.begin(), copies.end(), rng);
+    std::stable_sort(copies.begin(), copies.end(),
+                     [&holders](int a, int b) { return holders[a] < holders[b]; });
+
+    std::array<int, kMaxPlayers> capacity{};
+    size_t seats_total = 0;
+    for (uint64_t p = 0; p < num_players; p++) {
+        if (p == my_seat) continue;
+        capacity[p] = static_cast<int>(hand_count[p]);
+        seats_total += hand_count[p];
+    }
+    if (seats_total != copies.size()) return false;
+
+    std::vector<std::vector<int>> assigned(num_players);
+    std::vector<int> parent(num_players);
+    std::vector<int> parent_slot(num_players);
+    std::vector<uint64_t> queue;
+    queue.reserve(num_players);
+
+    for (int id : copies) {
+        // Weighted pick among seats that may hold the card and have room
+        int total_room = 0;
+        for (uint64_t p = 0; p < num_players; p++) {
+            if (p != my_seat && (possible[p] >> id & 1ULL)) total_room += capacity[p];
+        }
+        if (total_room > 0) {
+            int pick = std::uniform_int_distribution<int>(0, total_room - 1)(rng);
+            for (uint64_t p = 0; p < num_players; p++) {
+                if (p == my_seat || !(possible[p] >> id & 1ULL)) continue;
+                pick -= capacity[p];
+                if (pick < 0) {
+                    assigned[p].push_back(id);
+                    capacity[p]--;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        // Every candidate is full: find an augmenting chain of card moves
+        // ending at a seat with room (breadth-first over seats).
+        std::fill(parent.begin(), parent.end(), -2);
+        queue.clear();
+        for (uint64_t p = 0; p < num_players; p++) {
+            if (p != my_seat && (possible[p] >> id & 1ULL)) {
+                parent[p] = -1;
+                queue.push_back(p);
+            }
+        }
+        int target = -1;
+        for (size_t head = 0; head < queue.size() && target < 0; head++) {
+            uint64_t from = queue[head];
+            for (size_t slot = 0; slot < assigned[from].size() && target < 0; slot++) {
+                int moved = assigned[from][slot];
+                for (uint64_t to = 0; to < num_players; to++) {
+                    if (to == my_seat || parent[to] != -2 || !(possible[to] >> moved & 1ULL)) continue;
+                    parent[to] = static_cast<int>(from);
+                    parent_slot[to] = static_cast<int>(slot);
+                    if (capacity[to] > 0) {
+                        target = static_cast<int>(to);
+                        break;
+                    }
+                    queue.push_back(to);
+                }
+            }
+        }
+        if (target < 0) return false;
+
+        // Shift one card along the chain, then the freed root seat takes id
+        capacity[target]--;
+        int to = target;
+        while (parent[to] >= 0) {
+            int from = parent[to];
+            int slot = parent_slot[to];
+            assigned[to].push_back(assigned[from][slot]);
+            assigned[from][slot] = assigned[from].back();
+            assigned[from].pop_back();
+            to = from;
+        }
+        assigned[to].push_back(id);
+    }
+
+    hands.assign(num_players, std::vector<Card>());
+    for (uint64_t p = 0; p < num_players; p++) {
+        if (p == my_seat) {
+            for (int id = 0; id < kCards; id++) {
+                for (int c = 0; c < mine[id]; c++) hands[p].push_back(cardFromId(id));
+            }
+            continue;
+        }
+        hands[p].reserve(assigned[p].size());
+        for (int id : assigned[p]) hands[p].push_back(cardFromId(id));
+    }
+    return true;
+}
+
+} // namespace sevens
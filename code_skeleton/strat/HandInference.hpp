@@ -0,0 +1,79 @@
+#pragma once
+
+#include "PlayerStrategy.hpp"
+#include "../card/PackedCard.hpp"
+#include "../game/rules/GameRules.hpp"
+#include "../game/rules/GameState.hpp"
+#include "../game/rules/MoveGenerator.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Opponent hand inference for Sevens, meant to be embedded in a strategy.
+ *
+ * Keeps a 52 x N constraint matrix (one 52-bit mask per seat of the cards
+ * that seat may still hold) and updates it from the engine's observations:
+ *   - a played card leaves every mask once all its copies are accounted for
+ *   - a pass proves the passer holds none of the currently playable cards
+ *
+ * Updates are a handful of bit operations. Ownership probabilities are
+ * derived on demand, and sampleDeal() draws hidden hands that satisfy every
+ * constraint and hand size (used for determinized search).
+ *
+ * Playability follows the layout of the rules given to the constructor, so
+ * a pass only rules out cards the table's rules would have let the passer
+ * play.
+ */
+class HandInference {
+public:
+    static constexpr int kCards = 52;
+    static constexpr int kMaxPlayers = 8;
+
+    explicit HandInference(const GameRules& rules = GameRules());
+
+    // Start a new game from the engine's lifecycle callback
+    void reset(const GameStartInfo& info);
+
+    // Feed the engine's observations, in the order they are delivered
+    void onMove(uint64_t playerID, const Card& card);
+    void onPass(uint64_t playerID);
+
+    // Constraint matrix access: bit id is set if the seat may hold card id
+    uint64_t possibleCards(uint64_t playerID) const { return possible[playerID]; }
+    uint64_t handSize(uint64_t playerID) const { return hand_count[playerID]; }
+    uint64_t playableMask() const;
+
+    // Estimated probability that playerID holds (a copy of) card
+    double probability(uint64_t playerID, const Card& card) const;
+
+    // Fill probs[playerID * 52 + cardID] for every seat and card
+    void probabilities(std::vector<double>& probs) const;
+
+    // Draw hidden hands consistent with every constraint. hands[mySeat] is
+    // our own hand. Returns false only if the constraints are contradictory.
+    bool sampleDeal(std::mt19937_64& rng, std::vector<std::vector<Card>>& hands) const;
+
+    static int cardId(const Card& card) { return PackedCard(card).id; }
+    static Card cardFromId(int id) { return PackedCard(static_cast<uint8_t>(id)).card(); }
+
+private:
+    uint64_t my_seat = 0;
+    uint64_t num_players = 0;
+    uint64_t num_decks = 1;
+    StateRules layout;        // Single deck: playable() on the table mask
+    MoveGenerator move_gen;   // More decks: per-card checks on the copy counts
+
+    std::array<uint64_t, kMaxPlayers> possible{};    // Constraint matrix, one row per seat
+    std::array<uint32_t, kMaxPlayers> hand_count{};  // Cards each seat still holds
+    std::array<uint8_t, kCards> hidden{};            // Copies not yet seen by us
+    std::array<uint8_t, kCards> mine{};              // Copies in our own hand
+    std::array<uint8_t, kCards> on_table{};          // Copies already played
+
+    void removeIfExhausted(int id);
+};
+
+} // namespace sevens
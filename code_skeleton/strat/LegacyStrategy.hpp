@@ -0,0 +1,60 @@
+#pragma once
+
+#include "PlayerStrategy.hpp"
+#include <stdexcept>
+#include <string>
+#include <dlfcn.h>
+
+namespace sevens {
+
+/**
+ * Adapter for strategy libraries that export no strategyAbiVersion(), i.e.
+ * that were built against the original interface. Their vtables end at
+ * getName(), so only the destructor and the original five methods may be
+ * called on them. Every virtual added since runs the base class default
+ * on the adapter instead (onGameStart() forwards to initialize()).
+ */
+class LegacyStrategy : public PlayerStrategy {
+public:
+    explicit LegacyStrategy(PlayerStrategy* inner) : inner(inner) {}
+    ~LegacyStrategy() override { delete inner; }
+
+    LegacyStrategy(const LegacyStrategy&) = delete;
+    LegacyStrategy& operator=(const LegacyStrategy&) = delete;
+
+    void initialize(uint64_t playerID) override { inner->initialize(playerID); }
+
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override {
+        return inner->selectCardToPlay(hand, tableLayout);
+    }
+
+    void observeMove(uint64_t playerID, const Card& playedCard) override { inner->observeMove(playerID, playedCard); }
+    void observePass(uint64_t playerID) override { inner->observePass(playerID); }
+    std::string getName() const override { return inner->getName(); }
+
+    // Interface version of a dlopen()ed library: 1 if it exports none.
+    // Throws std::runtime_error for any other version than this build's.
+    static int abiVersionOf(void* handle, const std::string& path) {
+        auto version = (StrategyAbiVersionFn) dlsym(handle, "strategyAbiVersion");
+        if (!version) return 1;
+        const int found = version();
+        if (found != kStrategyAbiVersion) {
+            throw std::runtime_error(path + " was built against strategy interface version " +
+                                     std::to_string(found) + ", expected " +
+                                     std::to_string(kStrategyAbiVersion));
+        }
+        return found;
+    }
+
+    // A fresh instance from a library of that version, wrapped if it needs it
+    static PlayerStrategy* adapt(PlayerStrategy* created, int abiVersion) {
+        return abiVersion == 1 ? new LegacyStrategy(created) : created;
+    }
+
+private:
+    PlayerStrategy* inner;
+};
+
+} // namespace sevens
@@ -0,0 +1,386 @@
+#include "MCTSStrategy.hpp"
+#include "../game/search/Arena.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace sevens {
+
+namespace {
+
+constexpr uint8_t kPass = PackedCard::kCount;  // Action id of a pass
+constexpr int kMaxDepth = 512;                 // More than the turns of any game
+constexpr unsigned kCheckEvery = 16;           // Playouts between budget checks
+constexpr double kRewardScale = 65536.0;       // Rewards are summed as fixed point
+
+inline uint64_t actionBit(uint8_t action) {
+    return 1ULL << action;
+}
+
+inline uint64_t nextRandom(uint64_t& state) {
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+// A uniformly chosen set bit of mask (mask != 0)
+inline uint8_t pickBit(uint64_t mask, uint64_t random) {
+    for (int skip = static_cast<int>(random % static_cast<uint64_t>(__builtin_popcountll(mask))); skip > 0; skip--) {
+        mask &= mask - 1;
+    }
+    return static_cast<uint8_t>(__builtin_ctzll(mask));
+}
+
+uint64_t maskOf(const std::vector<Card>& cards) {
+    uint64_t mask = 0;
+    for (const Card& card : cards) mask |= PackedCard(card).bit();
+    return mask;
+}
+
+uint64_t nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+// One action in the tree; statistics are shared by every thread on the tree
+struct MCTSStrategy::Node {
+    std::atomic<Node*> children{nullptr};
+    Node* sibling = nullptr;
+    std::atomic<uint64_t> expanded{0};   // Actions with a child, or one being added
+    std::atomic<uint64_t> reward{0};     // Sum of the mover's rewards, fixed point
+    std::atomic<uint32_t> visits{0};
+    std::atomic<uint32_t> available{0};  // Playouts in which the action was legal
+    std::atomic<uint32_t> in_flight{0};  // Playouts below this node right now
+    uint8_t action = kPass;
+    uint8_t seat = 0;                    // Who takes the action
+
+    Node() = default;
+    Node(uint8_t nodeAction, uint8_t nodeSeat) : action(nodeAction), seat(nodeSeat) {}
+};
+
+struct MCTSStrategy::Worker {
+    Arena arena;
+    uint64_t random = 1;
+    uint64_t iterations = 0;
+    uint64_t nodes = 0;
+};
+
+struct MCTSStrategy::Budget {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> iterations{0};
+    uint64_t limit = 0;
+    uint64_t deadline = 0;  // steady_clock nanoseconds
+};
+
+MCTSStrategy::MCTSStrategy(MCTSConfig searchConfig, const GameRules& gameRules)
+    : config(searchConfig), rules(gameRules), state_rules(StateRules::compile(gameRules)), inference(gameRules)
+{
+    if (config.seed == 0) {
+        config.seed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+    rng.seed(config.seed);
+
+    const unsigned threads = config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    tree_count = config.trees ? config.trees : std::max(1u, threads / 4);
+    tree_count = std::min(tree_count, threads);
+    for (unsigned t = 0; t < threads; t++) {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->random = rng() | 1;
+    }
+    roots.resize(tree_count);
+}
+
+MCTSStrategy::~MCTSStrategy() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        pool_stopping = true;
+    }
+    pool_wake.notify_all();
+    for (auto& thread : pool) thread.join();
+}
+
+void MCTSStrategy::initialize(uint64_t playerID) {
+    my_seat = playerID;
+    tracking = false;
+}
+
+void MCTSStrategy::onGameStart(const GameStartInfo& info) {
+    initialize(info.seat);
+    if (info.numDecks != 1 || info.numPlayers > GameState::kMaxPlayers) return;
+    inference.reset(info);
+    player_count = static_cast<uint8_t>(info.numPlayers);
+
+    public_state.hands.fill(0);
+    public_state.cards_left.fill(0);
+    public_state.hands[my_seat] = maskOf(info.hand);
+    for (uint64_t seat = 0; seat < info.numPlayers && seat < info.handSizes.size(); seat++) {
+        public_state.cards_left[seat] = static_cast<uint8_t>(info.handSizes[seat]);
+    }
+    start_table = maskOf(info.tableCards);
+
+    // We lead if we hold the opening card; if an opponent does, its first move tells who
+    const uint8_t first = state_rules.first_card;
+    const bool mine = first != PackedCard::kNone && (public_state.hands[my_seat] & PackedCard(first).bit());
+    lead_pending = first != PackedCard::kNone && !mine && !(start_table & PackedCard(first).bit());
+    startPublic(mine ? static_cast<uint8_t>(my_seat) : 0, mine);
+    tracking = true;
+}
+
+void MCTSStrategy::startPublic(uint8_t leadSeat, bool firstCardPending) {
+    public_state.begin(state_rules, player_count, leadSeat, firstCardPending);
+    public_state.table = start_table;
+}
+
+void MCTSStrategy::observeMove(uint64_t playerID, const Card& playedCard) {
+    if (!tracking) return;
+    inference.onMove(playerID, playedCard);
+    if (lead_pending) {
+        lead_pending = false;
+        startPublic(static_cast<uint8_t>(playerID), true);
+    }
+
+    // Anything our rules would not allow means we are not following this game
+    const PackedCard card(playedCard);
+    const uint64_t allowed = public_state.firstCardPending() ? PackedCard(public_state.first_card).bit()
+                                                             : state_rules.playable(public_state.table);
+    if (public_state.over() || public_state.toMove() != playerID || !(allowed & card.bit())) {
+        tracking = false;
+        return;
+    }
+    public_state.play(card);
+}
+
+void MCTSStrategy::observePass(uint64_t playerID) {
+    if (!tracking) return;
+    inference.onPass(playerID);
+    if (lead_pending || public_state.over() || public_state.toMove() != playerID) {
+        tracking = false;
+        return;
+    }
+    public_state.pass();
+}
+
+int MCTSStrategy::fallback(const std::vector<Card>& hand) const {
+    // GreedyStrategy's order: farthest from 7 first, then higher suit
+    int best = 0;
+    for (int i = 1; i < static_cast<int>(hand.size()); i++) {
+        if (PackedCard(hand[i]).priority() > PackedCard(hand[best]).priority()) best = i;
+    }
+    return best;
+}
+
+int MCTSStrategy::selectCardToPlay(
+    const std::vector<Card>& hand,
+    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout)
+{
+    (void)tableLayout;
+    last_iterations = 0;
+    last_nodes = 0;
+    if (hand.empty()) return -1;
+    if (hand.size() == 1) return 0;
+
+    const uint64_t deadline = nowNanos() + config.moveMillis * 1000000;
+    if (!tracking || lead_pending || public_state.over() || public_state.toMove() != my_seat ||
+        public_state.legalMoves(state_rules) != maskOf(hand)) {
+        return fallback(hand);
+    }
+
+    // Deals consistent with every observation so far
+    samples.clear();
+    for (unsigned i = 0; i < std::max(1u, config.determinizations); i++) {
+        if (!inference.sampleDeal(rng, sample_hands)) break;
+        GameState deal = public_state;
+        for (uint64_t seat = 0; seat < public_state.num_players; seat++) {
+            if (seat != my_seat) deal.hands[seat] = maskOf(sample_hands[seat]);
+        }
+        samples.push_back(deal);
+    }
+    if (samples.empty()) return fallback(hand);
+
+    const uint8_t action = search(deadline);
+    for (int i = 0; i < static_cast<int>(hand.size()); i++) {
+        if (PackedCard(hand[i]).id == action) return i;
+    }
+    return fallback(hand);
+}
+
+uint8_t MCTSStrategy::search(uint64_t deadlineNanos) {
+    Budget budget;
+    budget.limit = config.maxIterations;
+    budget.deadline = deadlineNanos;
+
+    for (auto& worker : workers) {
+        worker->arena.reset();
+        worker->iterations = 0;
+        worker->nodes = 0;
+    }
+    for (unsigned tree = 0; tree < tree_count; tree++) roots[tree] = workers[tree]->arena.make<Node>();
+
+    if (pool.empty()) {
+        for (size_t w = 1; w < workers.size(); w++) pool.emplace_back(&MCTSStrategy::poolLoop, this, w);
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        pool_budget = &budget;
+        pool_running = pool.size();
+        pool_generation++;
+    }
+    pool_wake.notify_all();
+    runWorker(*workers[0], roots[0], budget);
+    {
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        pool_done.wait(lock, [this]() { return pool_running == 0; });
+        pool_budget = nullptr;
+    }
+
+    // Root parallelism: sum the trees' visits per move
+    std::array<uint64_t, kPass + 1> visits{};
+    std::array<uint64_t, kPass + 1> rewards{};
+    for (Node* root : roots) {
+        for (Node* child = root->children.load(std::memory_order_acquire); child; child = child->sibling) {
+            visits[child->action] += child->visits.load(std::memory_order_relaxed);
+            rewards[child->action] += child->reward.load(std::memory_order_relaxed);
+        }
+    }
+    for (const auto& worker : workers) {
+        last_iterations += worker->iterations;
+        last_nodes += worker->nodes;
+    }
+
+    uint8_t best = kPass;
+    for (uint8_t action = 0; action < kPass; action++) {
+        if (visits[action] == 0) continue;
+        // Most visits; equal counts go to the better mean
+        if (best == kPass || visits[action] > visits[best] ||
+            (visits[action] == visits[best] && rewards[action] > rewards[best])) {
+            best = action;
+        }
+    }
+    return best;
+}
+
+void MCTSStrategy::poolLoop(size_t w) {
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    uint64_t seen = 0;
+    while (true) {
+        pool_wake.wait(lock, [this, &seen]() { return pool_stopping || pool_generation != seen; });
+        if (pool_stopping) return;
+        seen = pool_generation;
+        Budget& budget = *pool_budget;
+        lock.unlock();
+        // A helper that wakes after the budget ran out returns at once
+        runWorker(*workers[w], roots[w % tree_count], budget);
+        lock.lock();
+        if (--pool_running == 0) pool_done.notify_one();
+    }
+}
+
+void MCTSStrategy::runWorker(Worker& worker, Node* root, Budget& budget) {
+    while (!budget.stop.load(std::memory_order_relaxed)) {
+        for (unsigned i = 0; i < kCheckEvery; i++) playout(worker, root);
+        const uint64_t done = budget.iterations.fetch_add(kCheckEvery, std::memory_order_relaxed) + kCheckEvery;
+        if ((budget.limit != 0 && done >= budget.limit) || nowNanos() >= budget.deadline) {
+            budget.stop.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+void MCTSStrategy::playout(Worker& worker, Node* root) {
+    GameState state = samples[nextRandom(worker.random) % samples.size()];
+    std::array<Node*, kMaxDepth> path;
+    int depth = 0;
+
+    // Selection: UCB among the children legal in this deal, until one action is added
+    Node* node = root;
+    bool added = false;
+    while (!added && !state.over() && depth < kMaxDepth) {
+        const uint64_t legal = state.legalMoves(state_rules);
+        const uint64_t actions = legal ? legal : actionBit(kPass);
+
+        Node* next = nullptr;
+        double best = -1.0;
+        for (Node* child = node->children.load(std::memory_order_acquire); child; child = child->sibling) {
+            if (!(actions & actionBit(child->action))) continue;
+            const uint32_t available = child->available.fetch_add(1, std::memory_order_relaxed) + 1;
+            const uint32_t visits = child->visits.load(std::memory_order_relaxed) +
+                                    child->in_flight.load(std::memory_order_relaxed) * config.virtualLoss;
+            const double score = visits == 0
+                ? 1e9
+                : static_cast<double>(child->reward.load(std::memory_order_relaxed)) / kRewardScale / visits +
+                      config.exploration * std::sqrt(std::log(static_cast<double>(available)) / visits);
+            if (score > best) {
+                best = score;
+                next = child;
+            }
+        }
+
+        // Expansion: any action legal here without a node yet comes first
+        const uint64_t untried = actions & ~node->expanded.load(std::memory_order_relaxed);
+        if (untried) {
+            const uint8_t action = pickBit(untried, nextRandom(worker.random));
+            if (!(node->expanded.fetch_or(actionBit(action), std::memory_order_relaxed) & actionBit(action))) {
+                Node* child = worker.arena.make<Node>(action, state.toMove());
+                child->available.store(1, std::memory_order_relaxed);
+                Node* head = node->children.load(std::memory_order_relaxed);
+                do {
+                    child->sibling = head;
+                } while (!node->children.compare_exchange_weak(head, child, std::memory_order_release,
+                                                               std::memory_order_relaxed));
+                worker.nodes++;
+                next = child;
+                added = true;
+            }
+        }
+        if (!next) break;  // Another thread is adding the only legal action
+
+        next->in_flight.fetch_add(1, std::memory_order_relaxed);
+        path[depth++] = next;
+        if (next->action == kPass) state.pass();
+        else state.play(PackedCard(next->action));
+        node = next;
+    }
+
+    // Simulation: uniformly random legal moves to the end of the game
+    while (!state.over()) {
+        const uint64_t legal = state.legalMoves(state_rules);
+        if (legal) state.play(PackedCard(pickBit(legal, nextRandom(worker.random))));
+        else state.pass();
+    }
+
+    // Backpropagation: each node scores the result of the seat that chose it
+    const auto ranks = state.ranks(rules.tieBreak);
+    const uint64_t players = state.num_players;
+    std::array<uint64_t, GameState::kMaxPlayers> reward{};
+    for (uint64_t seat = 0; seat < players; seat++) {
+        reward[seat] = static_cast<uint64_t>((players - ranks[seat]) * kRewardScale / (players - 1));
+    }
+    for (int i = 0; i < depth; i++) {
+        Node* step = path[i];
+        step->reward.fetch_add(reward[step->seat], std::memory_order_relaxed);
+        step->visits.fetch_add(1, std::memory_order_relaxed);
+        step->in_flight.fetch_sub(1, std::memory_order_relaxed);
+    }
+    worker.iterations++;
+}
+
+std::string MCTSStrategy::getName() const {
+    return "MCTSStrategy";
+}
+
+} // namespace sevens
+
+#ifdef BUILD_SHARED_LIB
+extern "C" sevens::PlayerStrategy* createStrategy() {
+    return new sevens::MCTSStrategy();
+}
+
+extern "C" int strategyAbiVersion() {
+    return sevens::kStrategyAbiVersion;
+}
+#endif
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "PlayerStrategy.hpp"
+#include "HandInference.hpp"
+#include "../game/rules/GameRules.hpp"
+#include "../game/rules/GameState.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Search settings for MCTSStrategy.
+ *   moveMillis:       wall-clock budget per decision, sampling included
+ *   maxIterations:    cap on playouts per decision (0 = until the time is up)
+ *   threads:          search threads (0 = one per core)
+ *   trees:            independent trees the threads are spread over (0 = one
+ *                     per four threads); their root statistics are summed
+ *   determinizations: hidden-hand samples drawn per decision
+ *   exploration:      UCB constant; rewards are in [0, 1]
+ *   virtualLoss:      losses a thread charges to the path it is exploring
+ *   seed:             0 = seeded from the clock
+ */
+struct MCTSConfig {
+    uint64_t moveMillis = 100;
+    uint64_t maxIterations = 0;
+    unsigned threads = 0;
+    unsigned trees = 0;
+    unsigned determinizations = 256;
+    double exploration = 0.7;
+    unsigned virtualLoss = 3;
+    uint64_t seed = 0;
+};
+
+/**
+ * Information-set Monte Carlo tree search over determinized deals.
+ *
+ * The strategy follows the game through its observations in a GameState
+ * that holds only its own hand, and HandInference narrows down who may hold
+ * the rest. Each decision draws a pool of deals consistent with everything
+ * seen; every playout takes one of them, walks the tree by UCB among the
+ * actions legal in that deal (counting how often each was available),
+ * expands one new action, finishes the game with random moves and credits
+ * every node on the path with its mover's result, (N - rank) / (N - 1).
+ *
+ * Parallelism: threads that share a tree update atomic node statistics and
+ * add virtual loss to the nodes below them, so concurrent playouts spread
+ * over different lines; separate trees (root parallelism) share nothing and
+ * are merged by summing root visits. The most visited move is played.
+ * The helper threads are started by the first search and sleep between
+ * decisions. Playouts copy a 128-byte GameState and nodes come from
+ * per-thread arenas that are rewound every decision, so the search itself
+ * never allocates or starts a thread once warmed up.
+ *
+ * Falls back to the greedy order (farthest from 7 first) when it cannot
+ * follow the game: several decks, a driver that sends no observations
+ * (selectCardsBatch), or moves its rules do not allow. The table's rules are
+ * passed to the constructor and drive both the search and hand inference.
+ *
+ * Built with -DBUILD_SHARED_LIB (together with GameState.cpp,
+ * MoveGenerator.cpp, Arena.cpp and HandInference.cpp) it exports
+ * createStrategy() for competition, with the default settings.
+ */
+class MCTSStrategy : public PlayerStrategy {
+public:
+    explicit MCTSStrategy(MCTSConfig config = MCTSConfig(), const GameRules& rules = GameRules());
+    ~MCTSStrategy() override;
+
+    void initialize(uint64_t playerID) override;
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override;
+    void observeMove(uint64_t playerID, const Card& playedCard) override;
+    void observePass(uint64_t playerID) override;
+    void onGameStart(const GameStartInfo& info) override;
+    std::string getName() const override;
+
+    // Playouts run and nodes added by the last search (0 after a fallback)
+    uint64_t lastIterations() const { return last_iterations; }
+    uint64_t lastNodes() const { return last_nodes; }
+
+private:
+    struct Node;
+    struct Worker;
+    struct Budget;
+
+    MCTSConfig config;
+    GameRules rules;
+    StateRules state_rules;
+    std::vector<std::unique_ptr<Worker>> workers;
+    unsigned tree_count = 1;
+    std::vector<Node*> roots;   // One per tree; worker w searches tree w % tree_count
+
+    // Helper threads for workers 1.. (worker 0 runs on the caller's thread)
+    std::vector<std::thread> pool;
+    std::mutex pool_mutex;
+    std::condition_variable pool_wake;
+    std::condition_variable pool_done;
+    Budget* pool_budget = nullptr;
+    uint64_t pool_generation = 0;  // Bumped once per search
+    size_t pool_running = 0;       // Helpers still on the current search
+    bool pool_stopping = false;
+    std::mt19937_64 rng;
+
+    uint64_t my_seat = 0;
+    uint8_t player_count = 0;
+    bool tracking = false;      // public_state follows the game
+    bool lead_pending = false;  // An opponent owes the opening card: the lead is its first mover
+    uint64_t start_table = 0;
+    GameState public_state;     // Every hand but ours is empty
+    HandInference inference;
+    std::vector<GameState> samples;
+    std::vector<std::vector<Card>> sample_hands;
+
+    uint64_t last_iterations = 0;
+    uint64_t last_nodes = 0;
+
+    void startPublic(uint8_t leadSeat, bool firstCardPending);
+    int fallback(const std::vector<Card>& hand) const;
+    uint8_t search(uint64_t deadlineNanos);
+    void poolLoop(size_t w);
+    void runWorker(Worker& worker, Node* root, Budget& budget);
+    void playout(Worker& worker, Node* root);
+};
+
+} // namespace sevens
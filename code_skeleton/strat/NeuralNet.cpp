@@ -0,0 +1,214 @@
+#include "NeuralNet.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace sevens {
+
+namespace {
+
+constexpr size_t kHeaderSize = 12;
+
+// y[0..n) += a * w[0..n), n a multiple of 8
+inline void axpy(float* y, const float* w, float a, int n) {
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256 va = _mm256_set1_ps(a);
+    for (int i = 0; i < n; i += 8) {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(w + i), _mm256_loadu_ps(y + i)));
+    }
+#else
+    for (int i = 0; i < n; i++) y[i] += a * w[i];
+#endif
+}
+
+// Sum of a[i] * b[i], n a multiple of 8
+inline float dot(const float* a, const float* b, int n) {
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256 acc = _mm256_setzero_ps();
+    for (int i = 0; i < n; i += 8) {
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc);
+    }
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+    return _mm_cvtss_f32(sum);
+#else
+    float sum = 0.0f;
+    for (int i = 0; i < n; i++) sum += a[i] * b[i];
+    return sum;
+#endif
+}
+
+void readFloats(std::ifstream& file, std::vector<float>& out, size_t count, const std::string& path) {
+    out.resize(count);
+    if (!file.read(reinterpret_cast<char*>(out.data()), count * sizeof(float))) {
+        throw std::runtime_error("Truncated weights file: " + path);
+    }
+}
+
+void writeFloats(std::ofstream& file, const std::vector<float>& values) {
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+}
+
+} // namespace
+
+PolicyValueNet::PolicyValueNet(uint64_t seed)
+    : w1(kInputs * kHidden), b1(kHidden, 0.0f),
+      w2(kHidden * kHidden), b2(kHidden, 0.0f),
+      w3(kHidden * kOutputs), b3(kOutputs, 0.0f)
+{
+    std::mt19937_64 rng(seed);
+    auto init = [&rng](std::vector<float>& weights, int fanIn) {
+        std::normal_distribution<float> dist(0.0f, std::sqrt(2.0f / fanIn));
+        for (float& w : weights) w = dist(rng);
+    };
+    init(w1, kInputs);
+    init(w2, kHidden);
+    init(w3, kHidden);
+    // Start close to a uniform policy and a neutral value
+    for (float& w : w3) w *= 0.1f;
+}
+
+PolicyValueNet::PolicyValueNet(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Could not open weights file: " + path);
+    }
+    uint8_t header[kHeaderSize];
+    if (!file.read(reinterpret_cast<char*>(header), kHeaderSize) ||
+        std::memcmp(header, kMagic, 4) != 0) {
+        throw std::runtime_error("Not a weights file: " + path);
+    }
+    auto field = [&header](int offset) { return static_cast<int>(header[offset] | (header[offset + 1] << 8)); };
+    if (field(4) != kVersion) {
+        throw std::runtime_error("Unsupported weights version " + std::to_string(field(4)));
+    }
+    if (field(6) != kInputs || field(8) != kHidden || field(10) != kOutputs) {
+        throw std::runtime_error("Weights file " + path + " has a different network shape");
+    }
+    readFloats(file, w1, kInputs * kHidden, path);
+    readFloats(file, b1, kHidden, path);
+    readFloats(file, w2, kHidden * kHidden, path);
+    readFloats(file, b2, kHidden, path);
+    readFloats(file, w3, kHidden * kOutputs, path);
+    readFloats(file, b3, kOutputs, path);
+}
+
+void PolicyValueNet::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Could not create weights file: " + path);
+    }
+    uint8_t header[kHeaderSize] = {};
+    std::memcpy(header, kMagic, 4);
+    auto put = [&header](int offset, int value) {
+        header[offset] = static_cast<uint8_t>(value & 0xFF);
+        header[offset + 1] = static_cast<uint8_t>(value >> 8);
+    };
+    put(4, kVersion);
+    put(6, kInputs);
+    put(8, kHidden);
+    put(10, kOutputs);
+    file.write(reinterpret_cast<const char*>(header), kHeaderSize);
+    writeFloats(file, w1);
+    writeFloats(file, b1);
+    writeFloats(file, w2);
+    writeFloats(file, b2);
+    writeFloats(file, w3);
+    writeFloats(file, b3);
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Failed to write weights file: " + path);
+    }
+}
+
+void PolicyValueNet::forward(const float* input, Activations& act) const {
+    float* h1 = act.hidden1.data();
+    std::memcpy(h1, b1.data(), kHidden * sizeof(float));
+    for (int i = 0; i < kInputs; i++) {
+        if (input[i] != 0.0f) axpy(h1, &w1[i * kHidden], input[i], kHidden);
+    }
+    for (float& v : act.hidden1) v = v > 0.0f ? v : 0.0f;
+
+    float* h2 = act.hidden2.data();
+    std::memcpy(h2, b2.data(), kHidden * sizeof(float));
+    for (int j = 0; j < kHidden; j++) {
+        if (h1[j] > 0.0f) axpy(h2, &w2[j * kHidden], h1[j], kHidden);
+    }
+    for (float& v : act.hidden2) v = v > 0.0f ? v : 0.0f;
+
+    float* out = act.output.data();
+    std::memcpy(out, b3.data(), kOutputs * sizeof(float));
+    for (int j = 0; j < kHidden; j++) {
+        if (h2[j] > 0.0f) axpy(out, &w3[j * kOutputs], h2[j], kOutputs);
+    }
+    out[kValue] = std::tanh(out[kValue]);
+}
+
+void PolicyValueNet::backward(const float* input, const Activations& act, const float* dOutput,
+                              Gradients& grads) const {
+    alignas(32) float d3[kOutputs];
+    std::memcpy(d3, dOutput, sizeof(d3));
+    d3[kValue] *= 1.0f - act.output[kValue] * act.output[kValue];
+    for (int o = kValue + 1; o < kOutputs; o++) d3[o] = 0.0f;
+
+    alignas(32) float d2[kHidden];
+    for (int j = 0; j < kHidden; j++) {
+        const float h = act.hidden2[j];
+        d2[j] = h > 0.0f ? dot(&w3[j * kOutputs], d3, kOutputs) : 0.0f;
+        if (h > 0.0f) axpy(&grads.w3[j * kOutputs], d3, h, kOutputs);
+    }
+    axpy(grads.b3.data(), d3, 1.0f, kOutputs);
+
+    alignas(32) float d1[kHidden];
+    for (int j = 0; j < kHidden; j++) {
+        const float h = act.hidden1[j];
+        d1[j] = h > 0.0f ? dot(&w2[j * kHidden], d2, kHidden) : 0.0f;
+        if (h > 0.0f) axpy(&grads.w2[j * kHidden], d2, h, kHidden);
+    }
+    axpy(grads.b2.data(), d2, 1.0f, kHidden);
+
+    for (int i = 0; i < kInputs; i++) {
+        if (input[i] != 0.0f) axpy(&grads.w1[i * kHidden], d1, input[i], kHidden);
+    }
+    axpy(grads.b1.data(), d1, 1.0f, kHidden);
+    grads.samples++;
+}
+
+PolicyValueNet::Gradients PolicyValueNet::makeGradients() const {
+    Gradients grads;
+    grads.w1.assign(w1.size(), 0.0f);
+    grads.b1.assign(b1.size(), 0.0f);
+    grads.w2.assign(w2.size(), 0.0f);
+    grads.b2.assign(b2.size(), 0.0f);
+    grads.w3.assign(w3.size(), 0.0f);
+    grads.b3.assign(b3.size(), 0.0f);
+    return grads;
+}
+
+void PolicyValueNet::apply(Gradients& grads, float learningRate) {
+    if (grads.samples == 0) return;
+    const float scale = -learningRate / static_cast<float>(grads.samples);
+    auto step = [scale](std::vector<float>& weights, std::vector<float>& grad) {
+        for (size_t i = 0; i < weights.size(); i++) {
+            weights[i] += scale * grad[i];
+            grad[i] = 0.0f;
+        }
+    };
+    step(w1, grads.w1);
+    step(b1, grads.b1);
+    step(w2, grads.w2);
+    step(b2, grads.b2);
+    step(w3, grads.w3);
+    step(b3, grads.b3);
+    grads.samples = 0;
+}
+
+} // namespace sevens
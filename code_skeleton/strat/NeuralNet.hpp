@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Small policy/value MLP for Sevens:
+ *   168 inputs -> 64 ReLU -> 64 ReLU -> 52 policy logits + 1 value (tanh)
+ *
+ * Every layer is stored input-major (W[in][out], out padded to a multiple
+ * of 8), so a forward pass is one scaled row-add per non-zero input. The
+ * inputs are mostly 0/1 bitboards, which makes the first layer sparse, and
+ * each row-add is a handful of AVX2 FMAs (scalar fallback without __AVX2__).
+ * A full decision is ~15k multiply-adds, a couple of microseconds.
+ *
+ * Weights file (little-endian): magic "SVNN", version:u16, inputs:u16,
+ * hidden:u16, outputs:u16, then float32 W1 b1 W2 b2 W3 b3 in that order.
+ */
+class PolicyValueNet {
+public:
+    static constexpr char kMagic[4] = {'S', 'V', 'N', 'N'};
+    static constexpr uint16_t kVersion = 1;
+    static constexpr int kInputs = 168;
+    static constexpr int kHidden = 64;
+    static constexpr int kPolicy = 52;
+    static constexpr int kValue = 52;    // Output index of the value head
+    static constexpr int kOutputs = 56;  // 52 logits + value, padded to 8
+
+    struct Activations {
+        alignas(32) std::array<float, kHidden> hidden1;
+        alignas(32) std::array<float, kHidden> hidden2;
+        alignas(32) std::array<float, kOutputs> output;  // Logits, then tanh(value)
+    };
+
+    // Gradient accumulators with the same layout as the weights
+    struct Gradients {
+        std::vector<float> w1, b1, w2, b2, w3, b3;
+        uint64_t samples = 0;
+    };
+
+    // Randomly initialised (He) from `seed`
+    explicit PolicyValueNet(uint64_t seed = 1);
+    // Load a weights file; throws std::runtime_error on bad files
+    explicit PolicyValueNet(const std::string& path);
+
+    void save(const std::string& path) const;
+
+    void forward(const float* input, Activations& act) const;
+
+    // Backpropagate dOutput (gradient w.r.t. logits and the tanh value) into grads
+    void backward(const float* input, const Activations& act, const float* dOutput, Gradients& grads) const;
+
+    Gradients makeGradients() const;
+    // Plain SGD step with the averaged gradients, then zero them
+    void apply(Gradients& grads, float learningRate);
+
+private:
+    std::vector<float> w1, b1;  // [kInputs][kHidden], [kHidden]
+    std::vector<float> w2, b2;  // [kHidden][kHidden], [kHidden]
+    std::vector<float> w3, b3;  // [kHidden][kOutputs], [kOutputs]
+};
+
+} // namespace sevens
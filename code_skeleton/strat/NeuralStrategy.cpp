@@ -0,0 +1,184 @@
+#include "NeuralStrategy.hpp"
+#include "../card/PackedCard.hpp"
+#include <chrono>
+#include <cmath>
+
+namespace sevens {
+
+namespace {
+
+constexpr int kHandOffset = 0;
+constexpr int kTableOffset = 52;
+constexpr int kFrontierOffset = 104;
+constexpr int kOpponentOffset = 156;
+constexpr int kOwnCountOffset = 163;
+constexpr int kPlayersOffset = 164;
+
+void setBits(float* out, uint64_t mask) {
+    while (mask) {
+        out[__builtin_ctzll(mask)] = 1.0f;
+        mask &= mask - 1;
+    }
+}
+
+} // namespace
+
+NeuralStrategy::NeuralStrategy(std::shared_ptr<const PolicyValueNet> net, const GameRules& rules)
+    : net(std::move(net)),
+      rng(std::chrono::system_clock::now().time_since_epoch().count()),
+      layout(StateRules::compile(rules))
+{
+    activations.output.fill(0.0f);
+}
+
+void NeuralStrategy::setTraining(std::shared_ptr<std::vector<PolicyEpisode>> sink, uint64_t seed) {
+    episodes = std::move(sink);
+    rng.seed(seed);
+}
+
+void NeuralStrategy::initialize(uint64_t playerID) {
+    myID = playerID;
+    trajectory.clear();
+}
+
+void NeuralStrategy::onGameStart(const GameStartInfo& info) {
+    initialize(info.seat);
+    numPlayers = info.numPlayers;
+    own_hand = SuitIsomorphism::handMask(info.hand);
+    cards_left.fill(0);
+    for (size_t seat = 0; seat < info.handSizes.size() && seat < cards_left.size(); seat++) {
+        cards_left[seat] = static_cast<uint32_t>(info.handSizes[seat]);
+    }
+}
+
+SuitPermutation NeuralStrategy::encode(uint64_t hand, uint64_t table, bool withCounts) {
+    const CanonicalState state = SuitIsomorphism::canonicalize(hand, table);
+    features.fill(0.0f);
+    setBits(&features[kHandOffset], state.hand());
+    setBits(&features[kTableOffset], state.table());
+    // Unlock rules are the same for every suit, so they apply to the canonical table as is
+    setBits(&features[kFrontierOffset], layout.playable(state.table()));
+    features[kOwnCountOffset] = __builtin_popcountll(hand) / 13.0f;
+    if (withCounts && numPlayers > 0) {
+        for (uint64_t offset = 1; offset < numPlayers && offset < 8; offset++) {
+            const uint64_t seat = (myID + offset) % numPlayers;
+            features[kOpponentOffset + offset - 1] = seat < cards_left.size() ? cards_left[seat] / 13.0f : 0.0f;
+        }
+        features[kPlayersOffset] = numPlayers / 8.0f;
+    }
+    return state.perm;
+}
+
+int NeuralStrategy::choose(const std::vector<Card>& moves, const SuitPermutation& perm, bool record) {
+    net->forward(features.data(), activations);
+    const float* logits = activations.output.data();
+
+    int best = 0;
+    float bestLogit = -INFINITY;
+    for (size_t i = 0; i < moves.size(); i++) {
+        const float logit = logits[PackedCard(perm.canonical(moves[i])).id];
+        if (logit > bestLogit) {
+            bestLogit = logit;
+            best = static_cast<int>(i);
+        }
+    }
+    if (!episodes || !record) return best;
+
+    // Training: sample from the softmax over the legal cards and remember the step
+    PolicyStep step;
+    step.features = features;
+    step.legal = 0;
+    step.value = logits[PolicyValueNet::kValue];
+    float total = 0.0f;
+    std::array<float, 52> weight{};
+    for (const Card& move : moves) {
+        const int id = PackedCard(perm.canonical(move)).id;
+        if (step.legal & (1ULL << id)) continue;
+        step.legal |= 1ULL << id;
+        weight[id] = std::exp(logits[id] - bestLogit);
+        total += weight[id];
+    }
+    std::uniform_real_distribution<float> dist(0.0f, total);
+    float pick = dist(rng);
+    int choice = best;
+    for (size_t i = 0; i < moves.size(); i++) {
+        const int id = PackedCard(perm.canonical(moves[i])).id;
+        pick -= weight[id];
+        weight[id] = 0.0f;  // Duplicate copies of a card count once
+        if (pick <= 0.0f) {
+            choice = static_cast<int>(i);
+            break;
+        }
+    }
+    step.action = PackedCard(perm.canonical(moves[choice])).id;
+    trajectory.push_back(step);
+    return choice;
+}
+
+int NeuralStrategy::selectCardToPlay(
+    const std::vector<Card>& hand,
+    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout)
+{
+    if (hand.empty()) {
+        return -1;
+    }
+    // The engine only passes the playable cards; the rest of the hand is own_hand
+    const SuitPermutation perm = encode(own_hand | SuitIsomorphism::handMask(hand),
+                                        SuitIsomorphism::tableMask(tableLayout), true);
+    return choose(hand, perm, true);
+}
+
+void NeuralStrategy::selectCardsBatch(const std::vector<BatchDecision>& positions, std::vector<int>& choices) {
+    choices.resize(positions.size());
+    for (size_t p = 0; p < positions.size(); p++) {
+        const BatchDecision& position = positions[p];
+        if (position.validMoves->empty()) {
+            choices[p] = -1;
+            continue;
+        }
+        const SuitPermutation perm = encode(SuitIsomorphism::handMask(*position.heldCards),
+                                            SuitIsomorphism::tableMask(*position.tableLayout), false);
+        choices[p] = choose(*position.validMoves, perm, false);
+    }
+}
+
+void NeuralStrategy::observeMove(uint64_t playerID, const Card& playedCard) {
+    if (playerID < cards_left.size() && cards_left[playerID] > 0) {
+        cards_left[playerID]--;
+    }
+    if (playerID == myID) {
+        own_hand &= ~PackedCard(playedCard).bit();
+    }
+}
+
+void NeuralStrategy::observePass(uint64_t playerID) {
+    (void)playerID;
+}
+
+void NeuralStrategy::onGameEnd(uint64_t finalRank) {
+    if (!episodes || trajectory.empty()) return;
+
+    PolicyEpisode episode;
+    episode.ret = numPlayers > 1
+        ? 1.0f - 2.0f * static_cast<float>(finalRank - 1) / static_cast<float>(numPlayers - 1)
+        : 0.0f;
+    episode.steps.swap(trajectory);
+    episodes->push_back(std::move(episode));
+}
+
+std::string NeuralStrategy::getName() const {
+    return "NeuralStrategy";
+}
+
+} // namespace sevens
+
+#ifdef BUILD_SHARED_LIB
+extern "C" sevens::PlayerStrategy* createStrategy() {
+    // Shared-library builds load "neural.bin" from the working directory
+    return new sevens::NeuralStrategy(std::make_shared<sevens::PolicyValueNet>(std::string("neural.bin")));
+}
+
+extern "C" int strategyAbiVersion() {
+    return sevens::kStrategyAbiVersion;
+}
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "PlayerStrategy.hpp"
+#include "NeuralNet.hpp"
+#include "../game/rules/GameRules.hpp"
+#include "../game/rules/GameState.hpp"
+#include "../card/SuitIsomorphism.hpp"
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace sevens {
+
+/**
+ * One decision recorded in training mode: the inputs, the legal cards and
+ * the card chosen (canonical IDs), and the value head's estimate at the time.
+ */
+struct PolicyStep {
+    std::array<float, PolicyValueNet::kInputs> features;
+    uint64_t legal;
+    int action;
+    float value;
+};
+
+// A finished game from one seat: its decisions and the final return in [-1, 1]
+struct PolicyEpisode {
+    std::vector<PolicyStep> steps;
+    float ret = 0.0f;
+};
+
+/**
+ * Strategy backed by PolicyValueNet.
+ *
+ * Features are taken after suit canonicalization (SuitIsomorphism over hand
+ * and table), so the net only ever sees one of the 24 equivalent labellings:
+ *   [0, 52)    cards in our hand
+ *   [52, 104)  cards on the table
+ *   [104, 156) table frontier: cards that are playable right now
+ *   [156, 163) cards left per opponent / 13, by seat offset 1..7 from us
+ *   [163]      our own cards left / 13
+ *   [164]      number of players / 8
+ * The move is the legal card with the highest policy logit.
+ *
+ * In training mode moves are sampled from the softmax over legal cards and
+ * every decision is recorded; onGameEnd() turns the final rank into a return
+ * (+1 for first place down to -1 for last) and appends the episode to the
+ * shared buffer. Updating the net is up to the trainer (ActorCriticUpdater).
+ */
+class NeuralStrategy : public PlayerStrategy {
+public:
+    // The frontier inputs follow the layout of `rules`
+    explicit NeuralStrategy(std::shared_ptr<const PolicyValueNet> net, const GameRules& rules = GameRules());
+
+    // Sample moves and record finished games into episodes (nullptr: play greedily)
+    void setTraining(std::shared_ptr<std::vector<PolicyEpisode>> episodes, uint64_t seed);
+
+    // Play with another net from the next decision on (league opponents)
+    void setNet(std::shared_ptr<const PolicyValueNet> newNet) { net = std::move(newNet); }
+
+    void initialize(uint64_t playerID) override;
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override;
+    // Positions carry no seat counts, so inputs 156..162 and 164 stay zero here
+    void selectCardsBatch(const std::vector<BatchDecision>& positions, std::vector<int>& choices) override;
+    void observeMove(uint64_t playerID, const Card& playedCard) override;
+    void observePass(uint64_t playerID) override;
+    void onGameStart(const GameStartInfo& info) override;
+    void onGameEnd(uint64_t finalRank) override;
+    std::string getName() const override;
+
+    // Value head's estimate of the final return from the last decision
+    float lastValue() const { return activations.output[PolicyValueNet::kValue]; }
+
+private:
+    using Features = std::array<float, PolicyValueNet::kInputs>;
+
+    std::shared_ptr<const PolicyValueNet> net;
+    std::shared_ptr<std::vector<PolicyEpisode>> episodes;
+    std::mt19937_64 rng;
+    StateRules layout;
+
+    uint64_t myID = 0;
+    uint64_t numPlayers = 0;
+    uint64_t own_hand = 0;
+    std::array<uint32_t, 8> cards_left{};
+
+    alignas(32) Features features{};
+    PolicyValueNet::Activations activations;
+    std::vector<PolicyStep> trajectory;
+
+    // Fill `features` for one position; returns the suit relabelling used
+    SuitPermutation encode(uint64_t hand, uint64_t table, bool withCounts);
+    // Index into moves of the chosen card; samples and records the step when
+    // training and `record` is set (batch positions belong to other games)
+    int choose(const std::vector<Card>& moves, const SuitPermutation& perm, bool record);
+};
+
+} // namespace sevens
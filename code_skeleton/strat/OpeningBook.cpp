@@ -0,0 +1,152 @@
+#include "OpeningBook.hpp"
+#include "../card/SuitIsomorphism.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace sevens {
+
+namespace {
+
+constexpr size_t kHeaderSize = 12;
+
+// n choose k for the small values the class index needs
+constexpr uint32_t choose(uint32_t n, uint32_t k) {
+    if (k > n) return 0;
+    uint32_t result = 1;
+    for (uint32_t i = 1; i <= k; i++) {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+
+static_assert(choose(OpeningBook::kSuitClasses + 3, 4) == OpeningBook::kEntries,
+              "Hand classes are the 4-multisets of suit classes");
+
+inline int tailBucket(int count) {
+    return count == 0 ? 0 : (count <= 2 ? 1 : 2);
+}
+
+} // namespace
+
+OpeningBook::OpeningBook(int openRank, uint8_t openSuits)
+    : open_rank(openRank),
+      open_suits(openSuits),
+      moves(kEntries, kNoMove)
+{
+}
+
+OpeningBook::OpeningBook(const std::string& path) : open_rank(7), open_suits(0x0F) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Could not open opening book: " + path);
+    }
+    uint8_t header[kHeaderSize];
+    if (!file.read(reinterpret_cast<char*>(header), kHeaderSize) ||
+        std::memcmp(header, kMagic, 4) != 0) {
+        throw std::runtime_error("Not an opening book: " + path);
+    }
+    const uint16_t version = static_cast<uint16_t>(header[4] | (header[5] << 8));
+    if (version != 1 && version != kVersion) {
+        throw std::runtime_error("Unsupported opening book version " + std::to_string(version));
+    }
+    open_rank = header[6];
+    if (version >= 2) open_suits = header[7];
+    uint32_t entries = 0;
+    for (int i = 0; i < 4; i++) entries |= static_cast<uint32_t>(header[8 + i]) << (8 * i);
+    if (entries != kEntries || open_rank < 1 || open_rank > 13 || open_suits == 0 || open_suits > 0x0F) {
+        throw std::runtime_error("Corrupt opening book header: " + path);
+    }
+
+    moves.resize(kEntries);
+    if (!file.read(reinterpret_cast<char*>(moves.data()), kEntries)) {
+        throw std::runtime_error("Truncated opening book: " + path);
+    }
+    for (uint8_t move : moves) {
+        if (move != kNoMove && move >= 8) {
+            throw std::runtime_error("Corrupt opening book entry in " + path);
+        }
+    }
+}
+
+void OpeningBook::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Could not create opening book: " + path);
+    }
+    uint8_t header[kHeaderSize] = {};
+    std::memcpy(header, kMagic, 4);
+    header[4] = static_cast<uint8_t>(kVersion & 0xFF);
+    header[5] = static_cast<uint8_t>(kVersion >> 8);
+    header[6] = static_cast<uint8_t>(open_rank);
+    header[7] = open_suits;
+    for (int i = 0; i < 4; i++) header[8 + i] = static_cast<uint8_t>(kEntries >> (8 * i));
+    file.write(reinterpret_cast<const char*>(header), kHeaderSize);
+    file.write(reinterpret_cast<const char*>(moves.data()), moves.size());
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Failed to write opening book: " + path);
+    }
+}
+
+uint32_t OpeningBook::classify(const std::vector<Card>& hand, std::array<int, 4>& slotSuit) const {
+    std::array<int, 4> below{};
+    std::array<int, 4> above{};
+    std::array<int, 4> adjacent{};  // bit 0: openRank-1, bit 1: openRank+1
+    for (const Card& card : hand) {
+        if (card.suit < 0 || card.suit > 3) continue;
+        if (card.rank == open_rank - 1) adjacent[card.suit] |= 1;
+        else if (card.rank == open_rank + 1) adjacent[card.suit] |= 2;
+        else if (card.rank < open_rank) below[card.suit]++;
+        else if (card.rank > open_rank) above[card.suit]++;
+    }
+
+    std::array<uint32_t, 4> suitClass;
+    for (int suit = 0; suit < 4; suit++) {
+        suitClass[suit] = static_cast<uint32_t>((adjacent[suit] * 3 + tailBucket(below[suit])) * 3 +
+                                                tailBucket(above[suit]));
+    }
+    // Sorting the classes makes suit-permuted hands share one entry
+    const SuitPermutation perm = SuitIsomorphism::order(suitClass);
+    for (int slot = 0; slot < 4; slot++) slotSuit[slot] = perm.toReal[slot];
+
+    // Rank of the sorted multiset: c0 <= c1 <= c2 <= c3 maps to the strictly
+    // increasing c_i + i, whose combinatorial number is dense in [0, kEntries)
+    uint32_t index = 0;
+    for (int slot = 0; slot < 4; slot++) {
+        index += choose(suitClass[slotSuit[slot]] + slot, slot + 1);
+    }
+    return index;
+}
+
+bool OpeningBook::lookup(const std::vector<Card>& hand, Card& card) const {
+    std::array<int, 4> slotSuit;
+    const uint8_t move = moves[classify(hand, slotSuit)];
+    if (move == kNoMove) {
+        return false;
+    }
+    card.suit = slotSuit[move / 2];
+    card.rank = (move & 1) ? open_rank + 1 : open_rank - 1;
+    return card.rank >= 1 && card.rank <= 13;
+}
+
+uint8_t OpeningBook::openSuitsOf(const GameRules& rules) {
+    uint8_t mask = 0;
+    for (const Card& card : rules.startCards) {
+        if (card.rank == rules.openRank && card.suit >= 0 && card.suit <= 3) mask |= 1 << card.suit;
+    }
+    return mask;
+}
+
+bool OpeningBook::matches(const GameRules& rules) const {
+    return rules.numDecks == 1 && rules.openRank == open_rank && openSuitsOf(rules) == open_suits;
+}
+
+uint32_t OpeningBook::knownEntries() const {
+    return static_cast<uint32_t>(std::count_if(moves.begin(), moves.end(),
+                                               [](uint8_t move) { return move != kNoMove; }));
+}
+
+} // namespace sevens
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../card/Generic_card_parser.hpp"
+#include "../game/rules/GameRules.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Precomputed first moves for the opening, indexed by hand class.
+ *
+ * With only the opening cards on the table the first decision depends on
+ * the player's own hand alone, and only on its shape around the opening
+ * rank. Each suit is reduced to one of 36 classes:
+ *   (holds openRank-1, holds openRank+1) x (cards further below: 0, 1-2, 3+)
+ *                                        x (cards further above: 0, 1-2, 3+)
+ * and since the suits are interchangeable the four suit classes are sorted
+ * and ranked as a multiset, giving C(39, 4) = 82,251 hand classes. Every
+ * class stores one byte: the recommended move as (sorted suit slot, side)
+ * or kNoMove when the book has no confident answer.
+ *
+ * Lookups are a pass over the hand plus a table read. Books are produced
+ * offline by opening_book_gen for one table layout: the opening rank and the
+ * suits whose opening card starts on the table (see matches()).
+ *
+ * File format (little-endian): magic "SVOB", version:u16, openRank:u8,
+ * openSuits:u8 (bit s: suit s starts open), entries:u32, then one byte per
+ * class. Version 1 books had no suit mask and are read as all four open.
+ */
+class OpeningBook {
+public:
+    static constexpr char kMagic[4] = {'S', 'V', 'O', 'B'};
+    static constexpr uint16_t kVersion = 2;
+    static constexpr int kSuitClasses = 36;
+    static constexpr uint32_t kEntries = 82251;
+    static constexpr uint8_t kNoMove = 0xFF;
+
+    // Empty book for the given layout (every lookup misses)
+    explicit OpeningBook(int openRank = 7, uint8_t openSuits = 0x0F);
+    // Load a book written by save(); throws std::runtime_error on bad files
+    explicit OpeningBook(const std::string& path);
+
+    void save(const std::string& path) const;
+
+    // Hand class of a hand; slotSuit[i] receives the real suit in sorted slot i
+    uint32_t classify(const std::vector<Card>& hand, std::array<int, 4>& slotSuit) const;
+
+    // Recommended opening card for this hand, false if the book has none
+    bool lookup(const std::vector<Card>& hand, Card& card) const;
+
+    // Raw access for the generator
+    static uint8_t encodeMove(int slot, bool above) { return static_cast<uint8_t>(slot * 2 + (above ? 1 : 0)); }
+    uint8_t entry(uint32_t handClass) const { return moves[handClass]; }
+    void setEntry(uint32_t handClass, uint8_t move) { moves[handClass] = move; }
+    int openRank() const { return open_rank; }
+    uint8_t openSuits() const { return open_suits; }
+    uint32_t knownEntries() const;
+
+    // Suits whose opening card the rules put on the table, as a bit mask
+    static uint8_t openSuitsOf(const GameRules& rules);
+    // Whether the book was built for the layout these rules deal
+    bool matches(const GameRules& rules) const;
+
+private:
+    int open_rank;
+    uint8_t open_suits;
+    std::vector<uint8_t> moves;
+};
+
+} // namespace sevens
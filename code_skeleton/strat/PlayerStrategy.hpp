@@ -6,6 +6,30 @@
 
 namespace sevens {
 
+/**
+ * Per-game context handed to a strategy by the engine when a new deal starts.
+ */
+struct GameStartInfo {
+    uint64_t seat;        // Player ID this strategy plays for in this game
+    uint64_t numPlayers;  // Number of players at the table
+    uint64_t numDecks;    // 52-card decks shuffled together
+    uint64_t dealSeed;    // Seed that produced this deal (reproducible)
+    std::vector<Card> hand;          // Cards dealt to this seat
+    std::vector<uint64_t> handSizes; // Cards dealt to every seat, indexed by seat
+    std::vector<Card> tableCards;    // Cards on the table before the first move
+};
+
+/**
+ * One pending decision handed to selectCardsBatch(); consecutive entries
+ * usually come from different games.
+ */
+struct BatchDecision {
+    uint64_t seat;                        // Seat to move in that game
+    const std::vector<Card>* validMoves;  // What selectCardToPlay() receives as `hand`
+    const std::vector<Card>* heldCards;   // Every card the seat still holds
+    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>* tableLayout;
+};
+
 /**
  * Interface for player strategy implementations.
  * Students will implement this interface to create their competitive agents.
@@ -31,9 +55,49 @@ public:
     
     // Get a name for this strategy (for display purposes)
     virtual std::string getName() const = 0;
+    
+    // Virtuals below are appended in the order they were added, so the slots
+    // of older ones never move for libraries built against an older header.
+    // Such libraries still lack them; see LegacyStrategy.
+    
+    // Called by the engine before the first move of every game.
+    // The default forwards to initialize() so older strategies keep working;
+    // override it to reset per-game state without reconstructing the object.
+    virtual void onGameStart(const GameStartInfo& info) {
+        initialize(info.seat);
+    }
+    
+    // Called by the engine once the game is over, with this seat's final rank
+    virtual void onGameEnd(uint64_t finalRank) {
+        (void)finalRank;
+    }
+    
+    // Whether observeMove/observePass do anything for this strategy.
+    // The engine skips the dispatch entirely for strategies returning false.
+    virtual bool wantsObservations() const {
+        return true;
+    }
+    
+    // Decide many positions in one call: choices[i] answers positions[i] the way
+    // selectCardToPlay() would. Batch drivers share one strategy object across
+    // all their games and send no observations, so an override must only use
+    // the positions themselves. The default loops over selectCardToPlay().
+    virtual void selectCardsBatch(const std::vector<BatchDecision>& positions, std::vector<int>& choices) {
+        choices.resize(positions.size());
+        for (size_t i = 0; i < positions.size(); i++) {
+            choices[i] = selectCardToPlay(*positions[i].validMoves, *positions[i].tableLayout);
+        }
+    }
 };
 
 // Type for strategy factory functions (for dynamic loading)
 typedef PlayerStrategy* (*CreateStrategyFn)();
 
+// Version of the interface above, bumped whenever a virtual is appended.
+// Libraries export it next to createStrategy:
+//   extern "C" int strategyAbiVersion() { return sevens::kStrategyAbiVersion; }
+// Libraries without it were built against the original five methods.
+constexpr int kStrategyAbiVersion = 2;
+typedef int (*StrategyAbiVersionFn)();
+
 } // namespace sevens
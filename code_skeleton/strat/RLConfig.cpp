@@ -0,0 +1,157 @@
+#include "RLConfig.hpp"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace sevens {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    size_t last = text.find_last_not_of(" \t\r");
+    return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+}
+
+const char* kindName(DecaySchedule::Kind kind) {
+    switch (kind) {
+        case DecaySchedule::Kind::Linear: return "linear";
+        case DecaySchedule::Kind::Exponential: return "exponential";
+        default: return "constant";
+    }
+}
+
+} // namespace
+
+double DecaySchedule::at(uint64_t episode) const {
+    if (kind == Kind::Constant) return start;
+    const double progress = episodes == 0 || episode >= episodes
+        ? 1.0 : static_cast<double>(episode) / static_cast<double>(episodes);
+    if (kind == Kind::Linear) return start + (target() - start) * progress;
+    return start * std::pow(target() / start, progress);
+}
+
+RLConfig RLConfig::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open config file: " + path);
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    return parse(text.str(), path);
+}
+
+RLConfig RLConfig::parse(const std::string& text, const std::string& source) {
+    std::istringstream lines(text);
+    RLConfig config;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        size_t eq = line.find('=');
+        try {
+            if (eq == std::string::npos) {
+                if (!trim(line).empty()) throw std::invalid_argument("expected key = value");
+                continue;
+            }
+            config.set(trim(line.substr(0, eq)), trim(line.substr(eq + 1)));
+        } catch (const std::invalid_argument& e) {
+            throw std::runtime_error(source + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    try {
+        config.validate();
+    } catch (const std::invalid_argument& e) {
+        throw std::runtime_error(source + ": " + e.what());
+    }
+    return config;
+}
+
+void RLConfig::set(const std::string& key, const std::string& value) {
+    auto toDouble = [&]() {
+        size_t used = 0;
+        double number = 0.0;
+        try {
+            number = std::stod(value, &used);
+        } catch (const std::logic_error&) {
+            used = 0;
+        }
+        if (used == 0 || used != value.size() || !std::isfinite(number)) {
+            throw std::invalid_argument(key + ": expected a number, got '" + value + "'");
+        }
+        return number;
+    };
+    auto toCount = [&]() {
+        double number = toDouble();
+        if (number < 0 || number != std::floor(number) || number >= 18446744073709551616.0) {
+            throw std::invalid_argument(key + ": expected a whole number, got '" + value + "'");
+        }
+        return static_cast<uint64_t>(number);
+    };
+    // Seeds use all 64 bits, which a double cannot hold exactly
+    auto toSeed = [&]() {
+        size_t used = 0;
+        uint64_t number = 0;
+        try {
+            if (value.find_first_not_of("0123456789") == std::string::npos) number = std::stoull(value, &used);
+        } catch (const std::logic_error&) {
+            used = 0;
+        }
+        if (used == 0 || used != value.size()) {
+            throw std::invalid_argument(key + ": expected a whole number below 2^64, got '" + value + "'");
+        }
+        return number;
+    };
+    auto toKind = [&]() {
+        if (value == "constant") return DecaySchedule::Kind::Constant;
+        if (value == "linear") return DecaySchedule::Kind::Linear;
+        if (value == "exponential") return DecaySchedule::Kind::Exponential;
+        throw std::invalid_argument(key + ": expected constant, linear or exponential");
+    };
+
+    if (key == "epsilon") epsilon.start = toDouble();
+    else if (key == "epsilon_end") epsilon.end = toDouble();
+    else if (key == "epsilon_decay") epsilon.kind = toKind();
+    else if (key == "epsilon_episodes") epsilon.episodes = toCount();
+    else if (key == "alpha") alpha.start = toDouble();
+    else if (key == "alpha_end") alpha.end = toDouble();
+    else if (key == "alpha_decay") alpha.kind = toKind();
+    else if (key == "alpha_episodes") alpha.episodes = toCount();
+    else if (key == "gamma") gamma = toDouble();
+    else if (key == "seed") seed = toSeed();
+    else throw std::invalid_argument("unknown setting '" + key + "'");
+}
+
+void RLConfig::validate() const {
+    auto check = [](const char* name, const DecaySchedule& schedule, bool positive) {
+        for (double v : {schedule.start, schedule.target()}) {
+            if (!(v >= 0.0 && v <= 1.0)) {  // Also rejects NaN
+                throw std::invalid_argument(std::string(name) + " must lie in [0, 1]");
+            }
+        }
+        if (positive && schedule.kind == DecaySchedule::Kind::Exponential &&
+            (schedule.start <= 0.0 || schedule.target() <= 0.0)) {
+            throw std::invalid_argument(std::string(name) + ": exponential decay needs values above 0");
+        }
+    };
+    check("epsilon", epsilon, true);
+    check("alpha", alpha, true);
+    if (!(gamma >= 0.0 && gamma <= 1.0)) {
+        throw std::invalid_argument("gamma must lie in [0, 1]");
+    }
+}
+
+std::string RLConfig::describe() const {
+    std::ostringstream out;
+    out.precision(17);
+    out << "epsilon = " << epsilon.start << "\nepsilon_end = " << epsilon.target()
+        << "\nepsilon_decay = " << kindName(epsilon.kind) << "\nepsilon_episodes = " << epsilon.episodes
+        << "\nalpha = " << alpha.start << "\nalpha_end = " << alpha.target()
+        << "\nalpha_decay = " << kindName(alpha.kind) << "\nalpha_episodes = " << alpha.episodes
+        << "\ngamma = " << gamma << "\nseed = " << seed << "\n";
+    return out.str();
+}
+
+} // namespace sevens
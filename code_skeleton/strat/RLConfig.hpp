@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace sevens {
+
+/**
+ * A value that moves from `start` to `end` over the first `episodes` episodes.
+ * An unset (NaN) end means the value stays at start.
+ *   Constant:    always start
+ *   Linear:      straight line, then end
+ *   Exponential: geometric interpolation (start and end must be > 0), then end
+ */
+struct DecaySchedule {
+    enum class Kind { Constant, Linear, Exponential };
+
+    Kind kind = Kind::Constant;
+    double start = 0.0;
+    double end = NAN;
+    uint64_t episodes = 1;
+
+    double at(uint64_t episode) const;
+    double target() const { return std::isnan(end) ? start : end; }
+};
+
+/**
+ * Hyperparameters of RLStrategy. The defaults reproduce the original
+ * hard-coded values (epsilon 0.3, alpha 0.1, gamma 0.9, no decay).
+ *
+ * Config files are `key = value` lines with # comments:
+ *   epsilon = 0.3            alpha = 0.1            gamma = 0.9
+ *   epsilon_end = 0.02       alpha_end = 0.01       seed = 0  (0: clock)
+ *   epsilon_decay = linear   alpha_decay = exponential
+ *   epsilon_episodes = 500000                alpha_episodes = 500000
+ */
+struct RLConfig {
+    DecaySchedule epsilon{DecaySchedule::Kind::Constant, 0.3, NAN, 1};  // Exploration rate
+    DecaySchedule alpha{DecaySchedule::Kind::Constant, 0.1, NAN, 1};    // Learning rate
+    double gamma = 0.9;                                                // Discount factor
+    uint64_t seed = 0;
+
+    // Throws std::runtime_error naming the file and line on bad input
+    static RLConfig load(const std::string& path);
+    // Same for config text held in memory; `source` names it in errors
+    static RLConfig parse(const std::string& text, const std::string& source);
+
+    // Apply one setting; throws std::invalid_argument for unknown keys or bad values
+    void set(const std::string& key, const std::string& value);
+
+    // Throws std::invalid_argument if a value is out of range
+    void validate() const;
+
+    // One line per setting, in the file format
+    std::string describe() const;
+};
+
+} // namespace sevens
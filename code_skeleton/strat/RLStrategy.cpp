@@ -1,20 +1,28 @@
 #include "RLStrategy.hpp"
+#include "Checkpoint.hpp"
+#include "../card/PackedCard.hpp"
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <random>
 #include <cmath>
 #include <chrono>
 #include <fstream>
+#include <sstream>
+#include <stdexcept>
 
 
 namespace sevens {
 
-RLStrategy::RLStrategy() : 
-    rng(std::chrono::system_clock::now().time_since_epoch().count()),
-    epsilon(0.3), // Exploration rate
-    alpha(0.1),   // Learning rate
-    gamma(0.9)    // Discount factor
+RLStrategy::RLStrategy(const RLConfig& config) : 
+    rng(config.seed ? config.seed : std::chrono::system_clock::now().time_since_epoch().count()),
+    config(config),
+    epsilon(config.epsilon.at(0)), // Exploration rate
+    alpha(config.alpha.at(0)),     // Learning rate
+    gamma(config.gamma)            // Discount factor
 {
+    config.validate();
+
     // Initialize Q-table with zeros
     for (int suit = 0; suit < 4; suit++) {
         for (int rank = 1; rank <= 13; rank++) {
@@ -31,6 +39,34 @@ void RLStrategy::initialize(uint64_t playerID) {
     last_reward = 0.0;
 }
 
+void RLStrategy::onGameStart(const GameStartInfo& info) {
+    initialize(info.seat);
+    numPlayers = info.numPlayers;
+    epsilon = config.epsilon.at(episodes_played);
+    alpha = config.alpha.at(episodes_played);
+    
+    // Forget the previous episode; clear() keeps the buckets allocated
+    observed_cards.clear();
+    own_hand = SuitIsomorphism::handMask(info.hand);
+    // Until our first decision, in case the engine plays a forced move for us
+    suit_perm = SuitIsomorphism::canonicalize(own_hand, SuitIsomorphism::handMask(info.tableCards)).perm;
+    
+    // The book is keyed on the dealt hand, which later calls don't see
+    opening_pending = opening_book && opening_book->lookup(info.hand, opening_move);
+}
+
+void RLStrategy::onGameEnd(uint64_t finalRank) {
+    (void)finalRank;
+    episodes_played++;
+}
+
+void RLStrategy::setOpeningBook(std::shared_ptr<const OpeningBook> book, const GameRules& rules) {
+    if (book && !book->matches(rules)) {
+        throw std::invalid_argument("Opening book was built for another table layout");
+    }
+    opening_book = std::move(book);
+}
+
 int RLStrategy::selectCardToPlay(
     const std::vector<Card>& hand,
     const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout)
@@ -42,32 +78,35 @@ int RLStrategy::selectCardToPlay(
     // Update state representation
     updateState(hand, tableLayout);
     
-    // Find valid moves
-    std::vector<int> validMoveIndices;
-    for (int i = 0; i < static_cast<int>(hand.size()); i++) {
-        if (isValidMove(hand[i], tableLayout)) {
-            validMoveIndices.push_back(i);
-        }
-    }
+    // `hand` is the engine's list of legal moves under the table's rules
+    const int moveCount = static_cast<int>(hand.size());
     
-    if (validMoveIndices.empty()) {
-        last_action = -1;
-        return -1;
+    // First move of the game straight from the opening book
+    int book_index = -1;
+    if (opening_pending) {
+        opening_pending = false;
+        for (int idx = 0; idx < moveCount; idx++) {
+            if (hand[idx].suit == opening_move.suit && hand[idx].rank == opening_move.rank) {
+                book_index = idx;
+            }
+        }
     }
     
     // Epsilon-greedy action selection
     std::uniform_real_distribution<double> dist(0.0, 1.0);
-    if (dist(rng) < epsilon) {
+    if (book_index >= 0) {
+        last_action = book_index;
+    } else if (dist(rng) < epsilon) {
         // Exploration: random move
-        std::uniform_int_distribution<int> actionDist(0, validMoveIndices.size() - 1);
-        last_action = validMoveIndices[actionDist(rng)];
+        std::uniform_int_distribution<int> actionDist(0, moveCount - 1);
+        last_action = actionDist(rng);
     } else {
         // Exploitation: choose best Q-value
         double best_value = -std::numeric_limits<double>::infinity();
-        int best_index = validMoveIndices[0];
+        int best_index = 0;
         
-        for (int idx : validMoveIndices) {
-            const Card& card = hand[idx];
+        for (int idx = 0; idx < moveCount; idx++) {
+            const Card card = suit_perm.canonical(hand[idx]);
             // Get Q-value for this card
             double q_value = q_values[card];
             
@@ -81,15 +120,65 @@ int RLStrategy::selectCardToPlay(
     
     // Remember the card we played
     if (last_action >= 0 && static_cast<size_t>(last_action) < hand.size()) {
-        last_card_played = hand[last_action];
+        last_card_played = suit_perm.canonical(hand[last_action]);
     }
     
     return last_action;
 }
 
+void RLStrategy::selectCardsBatch(const std::vector<BatchDecision>& positions, std::vector<int>& choices) {
+    // Dense copy of the Q-table, indexed by canonical card ID, once per batch
+    std::array<double, 52> q_dense{};
+    for (const auto& pair : q_values) {
+        q_dense[PackedCard(pair.first).id] = pair.second;
+    }
+    
+    // Flatten the candidates of every position into one list in canonical IDs...
+    batch_cards.clear();
+    for (const BatchDecision& position : positions) {
+        const SuitPermutation perm = SuitIsomorphism::canonicalize(
+            SuitIsomorphism::handMask(*position.heldCards),
+            SuitIsomorphism::tableMask(*position.tableLayout)).perm;
+        for (const Card& card : *position.validMoves) {
+            batch_cards.push_back(PackedCard(perm.toCanonical[card.suit], card.rank).id);
+        }
+    }
+    
+    // ...score them in a single gather pass...
+    batch_scores.resize(batch_cards.size());
+    for (size_t i = 0; i < batch_cards.size(); i++) {
+        batch_scores[i] = q_dense[batch_cards[i]];
+    }
+    
+    // ...and pick per position (epsilon-greedy, no learning updates)
+    choices.resize(positions.size());
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    size_t offset = 0;
+    for (size_t p = 0; p < positions.size(); p++) {
+        const int count = static_cast<int>(positions[p].validMoves->size());
+        if (count == 0) {
+            choices[p] = -1;
+        } else if (dist(rng) < epsilon) {
+            std::uniform_int_distribution<int> actionDist(0, count - 1);
+            choices[p] = actionDist(rng);
+        } else {
+            const double* scores = batch_scores.data() + offset;
+            choices[p] = static_cast<int>(std::max_element(scores, scores + count) - scores);
+        }
+        offset += count;
+    }
+}
+
 void RLStrategy::observeMove(uint64_t playerID, const Card& playedCard) {
     // Learn from moves
     if (playerID == myID) {
+        own_hand &= ~PackedCard(playedCard).bit();
+        
+        // The engine plays forced moves without asking us, so credit the card
+        // actually played rather than our last choice
+        last_card_played = suit_perm.canonical(playedCard);
+        opening_pending = false;
+        
         // Calculate immediate reward for our own move
         // Simple reward: +1 for playing a card
         double reward = 1.0;
@@ -122,56 +211,113 @@ std::string RLStrategy::getName() const {
 
 
 void RLStrategy::saveModel(const std::string& filename) {
-    std::ofstream file(filename);
-    for (const auto& pair : q_values) {
-        file << pair.first.suit << " " << pair.first.rank << " " << pair.second << "\n";
-    }
+    Checkpoint checkpoint;
+    checkpoint.put("rl", saveState());
+    checkpoint.put("config", config.describe());
+    checkpoint.writeAtomic(filename);
 }
 
 void RLStrategy::loadModel(const std::string& filename) {
+    if (Checkpoint::looksLike(filename)) {
+        loadState(Checkpoint::read(filename).get("rl"));
+        return;
+    }
+    
+    // Legacy text model: "suit rank value" for every card, in real suits
     std::ifstream file(filename);
-    int suit, rank;
-    double value;
-    while (file >> suit >> rank >> value) {
-        Card card{suit, rank};
-        q_values[card] = value;
+    if (!file) {
+        throw std::runtime_error("Could not open model file: " + filename);
+    }
+    std::array<double, 52> values{};
+    uint64_t seen = 0;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        std::istringstream fields(line);
+        int suit, rank;
+        double value;
+        std::string extra;
+        if (!(fields >> suit >> rank >> value) || (fields >> extra) ||
+            suit < 0 || suit > 3 || rank < 1 || rank > 13 || !std::isfinite(value)) {
+            throw std::runtime_error(filename + ":" + std::to_string(lineNumber) + ": malformed model line");
+        }
+        values[PackedCard(suit, rank).id] = value;
+        seen |= PackedCard(suit, rank).bit();
+    }
+    if (seen != (1ULL << 52) - 1) {
+        throw std::runtime_error("Incomplete model file " + filename + ": " +
+                                 std::to_string(__builtin_popcountll(seen)) + " of 52 cards");
+    }
+
+    // The Q-table is keyed on canonical suits now, and which real suit lands
+    // in which slot depends on the position, so each rank gets its mean
+    std::cerr << "[RLStrategy] " << filename << " is a real-suit text model (format 1); "
+              << "converted to canonical suits by averaging each rank" << std::endl;
+    for (int rank = 1; rank <= 13; rank++) {
+        double mean = 0.0;
+        for (int suit = 0; suit < 4; suit++) mean += values[PackedCard(suit, rank).id] / 4;
+        for (int suit = 0; suit < 4; suit++) q_values[Card{suit, rank}] = mean;
     }
 }
 
+std::string RLStrategy::saveState() const {
+    std::ostringstream out;
+    out.precision(17);
+    out << kStateTag << " " << kStateVersion << "\n";
+    for (int id = 0; id < 52; id++) {
+        auto it = q_values.find(PackedCard(static_cast<uint8_t>(id)).card());
+        out << (it == q_values.end() ? 0.0 : it->second) << " ";
+    }
+    out << episodes_played << " " << rng;
+    return out.str();
+}
 
+void RLStrategy::loadState(const std::string& bytes) {
+    std::istringstream in(bytes);
+    // Untagged states come from checkpoints written before the tag; the
+    // table was already canonical by then
+    if (bytes.compare(0, std::string(kStateTag).size(), kStateTag) == 0) {
+        std::string tag;
+        int version = 0;
+        in >> tag >> version;
+        if (version != kStateVersion) {
+            throw std::runtime_error("Unsupported RLStrategy state version " + std::to_string(version) +
+                                     " (expected " + std::to_string(kStateVersion) + ")");
+        }
+    }
+    std::array<double, 52> values;
+    for (double& value : values) in >> value;
+    uint64_t episodes;
+    std::mt19937 restored;
+    in >> episodes >> restored;
+    if (!in) {
+        throw std::runtime_error("Malformed RLStrategy state");
+    }
+    for (int id = 0; id < 52; id++) {
+        q_values[PackedCard(static_cast<uint8_t>(id)).card()] = values[id];
+    }
+    episodes_played = episodes;
+    rng = restored;
+}
 
 
 
 
 
-// Helper methods
 
-bool RLStrategy::isValidMove(const Card& card, 
-    const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) {
-    
-    // A card is valid if:
-    // 1. It is a 7, or
-    // 2. It is adjacent to a card already on table
-    
-    if (card.rank == 7) return true;
-    
-    auto suitIter = tableLayout.find(card.suit);
-    if (suitIter == tableLayout.end()) return false;
-    
-    if (card.rank < 7) {
-        // Check if card.rank+1 is on the table
-        auto rankIter = suitIter->second.find(card.rank + 1);
-        return (rankIter != suitIter->second.end() && rankIter->second);
-    } else { // card.rank > 7
-        // Check if card.rank-1 is on the table
-        auto rankIter = suitIter->second.find(card.rank - 1);
-        return (rankIter != suitIter->second.end() && rankIter->second);
-    }
-}
+
+// Helper methods
 
 void RLStrategy::updateState(const std::vector<Card>& hand,
     const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) {
     
+    // Canonical suit order for this decision; the engine only passes the
+    // playable cards, so the full hand comes from own_hand
+    suit_perm = SuitIsomorphism::canonicalize(own_hand | SuitIsomorphism::handMask(hand),
+                                              SuitIsomorphism::tableMask(tableLayout)).perm;
+    
     // Simple state representation as a string
     current_state.clear();
     
@@ -198,4 +344,8 @@ void RLStrategy::updateState(const std::vector<Card>& hand,
 extern "C" sevens::PlayerStrategy* createStrategy() {
     return new sevens::RLStrategy();
 }
+
+extern "C" int strategyAbiVersion() {
+    return sevens::kStrategyAbiVersion;
+}
 #endif
\ No newline at end of file
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "PlayerStrategy.hpp"
+#include "OpeningBook.hpp"
+#include "RLConfig.hpp"
+#include "../card/SuitIsomorphism.hpp"
+#include <memory>
 #include <random>
 #include <unordered_set>
 #include <unordered_map>
@@ -27,46 +31,89 @@ struct CardEqual {
  */
 class RLStrategy : public PlayerStrategy {
 public:
-    RLStrategy();
+    explicit RLStrategy(const RLConfig& config = RLConfig());
     ~RLStrategy() override = default;
     
     void initialize(uint64_t playerID) override;
     int selectCardToPlay(
         const std::vector<Card>& hand,
         const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override;
+    void selectCardsBatch(const std::vector<BatchDecision>& positions, std::vector<int>& choices) override;
     void observeMove(uint64_t playerID, const Card& playedCard) override;
     void observePass(uint64_t playerID) override;
+    void onGameStart(const GameStartInfo& info) override;
+    void onGameEnd(uint64_t finalRank) override;
     std::string getName() const override;
     
+    // Models are checkpoint files (atomic write, checksummed) whose state
+    // starts with a "sevens-rl <version>" line. loadModel also reads the old
+    // text format (version 1: real suits, complete 52-card tables only) and
+    // converts it to canonical suits; it throws std::runtime_error on
+    // anything else instead of keeping partial data.
     void saveModel(const std::string& filename);
     void loadModel(const std::string& filename);
+    
+    // Full learner state for exact resume: format line, Q-table, episodes played, RNG
+    std::string saveState() const;
+    void loadState(const std::string& bytes);
+    
+    // Play the book's first move when the dealt hand has an entry; throws
+    // std::invalid_argument if the book was built for another table layout
+    void setOpeningBook(std::shared_ptr<const OpeningBook> book, const GameRules& rules);
+    
+    // Hyperparameters; epsilon and alpha follow their schedules by episodes played
+    const RLConfig& getConfig() const { return config; }
+    uint64_t getEpisodes() const { return episodes_played; }
+    void setEpisodes(uint64_t episodes) { episodes_played = episodes; }
+    double getEpsilon() const { return epsilon; }
+    double getAlpha() const { return alpha; }
 
 
 private:
+    // Version 2: Q-table keyed on canonical suits (version 1 was real suits)
+    static constexpr const char* kStateTag = "sevens-rl";
+    static constexpr int kStateVersion = 2;
+
     uint64_t myID;
+    uint64_t numPlayers = 0;
     std::mt19937 rng;
     
-    // RL parameters
+    // RL parameters (epsilon and alpha are the current points of their schedules)
+    RLConfig config;
+    uint64_t episodes_played = 0;
     double epsilon; // Exploration rate
     double alpha;   // Learning rate
     double gamma;   // Discount factor
     
-    // Q-table: map from card to value
+    // Q-table: map from card to value. Cards are keyed in canonical suit order
+    // (SuitIsomorphism over hand + table), so symmetric states share values.
     std::unordered_map<Card, double, CardHash, CardEqual> q_values;
     
+    // Cards still in our hand (bit suit*13 + rank-1) and the current suit relabelling
+    uint64_t own_hand = 0;
+    SuitPermutation suit_perm;
+    
     // State representation
     std::string current_state;
     
-    // Memory of last action
+    // Memory of last action (last_card_played is canonical)
     int last_action;
     Card last_card_played;
     double last_reward;
     
+    // Opening book move for the current deal, if any
+    std::shared_ptr<const OpeningBook> opening_book;
+    bool opening_pending = false;
+    Card opening_move{0, 0};
+    
+    // Scratch space for selectCardsBatch (kept to avoid reallocating per batch)
+    std::vector<uint8_t> batch_cards;
+    std::vector<double> batch_scores;
+    
     // Set of observed cards played by others
     std::unordered_set<Card, CardHash, CardEqual> observed_cards;
     
     // Helper methods
-    bool isValidMove(const Card& card, const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout);
     void updateState(const std::vector<Card>& hand, const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout);
 };
 
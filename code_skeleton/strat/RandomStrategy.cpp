@@ -15,6 +15,10 @@ RandomStrategy::RandomStrategy() {
     rng.seed(seed);
 }
 
+void RandomStrategy::reseed(uint64_t seed) {
+    rng.seed(static_cast<unsigned long>(seed));
+}
+
 void RandomStrategy::initialize(uint64_t playerID) {
     myID = playerID;
     // No special initialization needed for this simplistic version
@@ -46,6 +50,10 @@ void RandomStrategy::observePass(uint64_t /*playerID*/) {
     // This simplified strategy ignores passes
 }
 
+bool RandomStrategy::wantsObservations() const {
+    return false; // Lets the engine skip the observe* calls entirely
+}
+
 std::string RandomStrategy::getName() const {
     return "RandomStrategy";
 }
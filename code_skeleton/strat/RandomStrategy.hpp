@@ -14,6 +14,9 @@ public:
     RandomStrategy();
     ~RandomStrategy() override = default;
     
+    // Restart the random sequence (reproducible runs and exact resume)
+    void reseed(uint64_t seed);
+    
     // PlayerStrategy interface
     void initialize(uint64_t playerID) override;
     int selectCardToPlay(
@@ -21,6 +24,7 @@ public:
         const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override;
     void observeMove(uint64_t playerID, const Card& playedCard) override;
     void observePass(uint64_t playerID) override;
+    bool wantsObservations() const override;
     std::string getName() const override;
     
 private:
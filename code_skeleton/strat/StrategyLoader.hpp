@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PlayerStrategy.hpp"
+#include "LegacyStrategy.hpp"
 #include <memory>
 #include <string>
 #include <dlfcn.h>
@@ -11,6 +12,8 @@ namespace sevens {
 
 /**
  * Utility class for loading player strategies from shared libraries.
+ * Libraries built against the original interface are wrapped in a
+ * LegacyStrategy; other interface versions are refused.
  */
 class StrategyLoader {
 public:
@@ -33,12 +36,21 @@ public:
             throw std::runtime_error("Could not find createStrategy: " + std::string(dlsym_error));
         }
         
+        int abiVersion;
+        try {
+            abiVersion = LegacyStrategy::abiVersionOf(handle, libraryPath);
+        } catch (...) {
+            dlclose(handle);
+            throw;
+        }
+        
         // Create the strategy
         PlayerStrategy* strategy = createStrategy();
         if (!strategy) {
             dlclose(handle);
             throw std::runtime_error("createStrategy returned nullptr");
         }
+        strategy = LegacyStrategy::adapt(strategy, abiVersion);
         
         // Custom deleter to handle cleanup of both the strategy and the library handle
         return std::shared_ptr<PlayerStrategy>(strategy, [handle](PlayerStrategy* s) {
@@ -0,0 +1,229 @@
+#include "StrategyRegistry.hpp"
+#include "LegacyStrategy.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sevens {
+
+// One dlopen()ed version of a library
+struct StrategyRegistry::Library {
+    typedef PlayerStrategy* (*CreateStrategyFn)();
+
+    void* handle = nullptr;
+    CreateStrategyFn createStrategy = nullptr;
+    int abi_version = kStrategyAbiVersion;
+    uint64_t generation = 0;
+
+    Library() = default;
+    Library(const Library&) = delete;
+    Library& operator=(const Library&) = delete;
+    ~Library() {
+        if (handle) dlclose(handle);
+    }
+};
+
+StrategyRegistry::StrategyRegistry(std::string cacheDir) : cache_dir(std::move(cacheDir)) {
+    if (cache_dir.empty()) {
+        cache_dir = (std::filesystem::temp_directory_path() / "sevens-strategies").string();
+    }
+    std::filesystem::create_directories(cache_dir);
+}
+
+StrategyRegistry::~StrategyRegistry() {
+    stopWatching();
+}
+
+bool StrategyRegistry::stampOf(const std::string& path, FileStamp& stamp) {
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) return false;
+    stamp.mtime_ns = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    stamp.size = static_cast<uint64_t>(info.st_size);
+    stamp.inode = static_cast<uint64_t>(info.st_ino);
+    return true;
+}
+
+std::shared_ptr<const StrategyRegistry::Library> StrategyRegistry::load(const std::string& name,
+                                                                        const std::string& path,
+                                                                        uint64_t generation) {
+    const std::string copy = (std::filesystem::path(cache_dir) /
+        (std::to_string(::getpid()) + "-" + std::to_string(copies++) + ".so")).string();
+    std::error_code ec;
+    std::filesystem::copy_file(path, copy, std::filesystem::copy_options::overwrite_existing, ec);
+    if (ec) {
+        throw std::runtime_error("Could not copy " + path + ": " + ec.message());
+    }
+
+    // Resolve every symbol now: a missing one should fail the reload, not a game
+    auto library = std::make_shared<Library>();
+    library->generation = generation;
+    library->handle = dlopen(copy.c_str(), RTLD_NOW | RTLD_LOCAL);
+    ::unlink(copy.c_str());
+    if (!library->handle) {
+        throw std::runtime_error("Could not open library " + path + ": " + std::string(dlerror()));
+    }
+
+    dlerror();
+    library->createStrategy = (Library::CreateStrategyFn) dlsym(library->handle, "createStrategy");
+    const char* dlsym_error = dlerror();
+    if (dlsym_error) {
+        throw std::runtime_error("Could not find createStrategy in " + path + ": " + std::string(dlsym_error));
+    }
+    library->abi_version = LegacyStrategy::abiVersionOf(library->handle, path);
+
+    // Smoke test before any game sees it
+    PlayerStrategy* probe = library->createStrategy();
+    if (!probe) {
+        throw std::runtime_error("createStrategy returned nullptr (" + name + ")");
+    }
+    delete probe;
+    return library;
+}
+
+void StrategyRegistry::add(const std::string& name, const std::string& path) {
+    Entry entry;
+    entry.path = path;
+    if (!stampOf(path, entry.loaded)) {
+        throw std::runtime_error("Could not open library: " + path);
+    }
+    entry.seen = entry.loaded;
+    entry.current = load(name, path, 1);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.count(name)) {
+        throw std::runtime_error("Strategy already registered: " + name);
+    }
+    entries.emplace(name, std::move(entry));
+}
+
+std::shared_ptr<PlayerStrategy> StrategyRegistry::create(const std::string& name, uint64_t* generation) const {
+    std::shared_ptr<const Library> library;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(name);
+        if (it == entries.end()) {
+            throw std::runtime_error("Unknown strategy: " + name);
+        }
+        library = it->second.current;
+    }
+    if (generation) *generation = library->generation;
+
+    PlayerStrategy* strategy = library->createStrategy();
+    if (!strategy) {
+        throw std::runtime_error("createStrategy returned nullptr (" + name + ")");
+    }
+    strategy = LegacyStrategy::adapt(strategy, library->abi_version);
+    // The deleter keeps the generation loaded until the instance is gone
+    return std::shared_ptr<PlayerStrategy>(strategy, [library](PlayerStrategy* s) { delete s; });
+}
+
+uint64_t StrategyRegistry::generation(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(name);
+    return it == entries.end() ? 0 : it->second.current->generation;
+}
+
+size_t StrategyRegistry::liveGenerations(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(name);
+    if (it == entries.end()) return 0;
+    size_t live = 1;
+    for (const auto& old : it->second.retired) {
+        if (!old.expired()) live++;
+    }
+    return live;
+}
+
+std::vector<std::string> StrategyRegistry::names() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> result;
+    for (const auto& entry : entries) result.push_back(entry.first);
+    return result;
+}
+
+std::vector<StrategyRegistry::Reload> StrategyRegistry::poll() {
+    std::lock_guard<std::mutex> polling(poll_mutex);
+
+    // Files that changed and have been stable since the previous poll
+    struct Candidate {
+        std::string name;
+        std::string path;
+        FileStamp stamp;
+        uint64_t generation;
+    };
+    std::vector<Candidate> candidates;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [name, entry] : entries) {
+            FileStamp stamp;
+            if (!stampOf(entry.path, stamp)) continue;  // Mid-replace; try again next poll
+            const bool stable = stamp == entry.seen;
+            entry.seen = stamp;
+            if (stable && stamp != entry.loaded && stamp != entry.failed) {
+                candidates.push_back({name, entry.path, stamp, entry.current->generation + 1});
+            }
+        }
+    }
+
+    std::vector<Reload> reloads;
+    for (const Candidate& candidate : candidates) {
+        Reload reload;
+        reload.name = candidate.name;
+        std::shared_ptr<const Library> library;
+        try {
+            library = load(candidate.name, candidate.path, candidate.generation);
+        } catch (const std::exception& e) {
+            reload.error = e.what();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& entry = entries.at(candidate.name);
+        if (library) {
+            entry.retired.erase(std::remove_if(entry.retired.begin(), entry.retired.end(),
+                                               [](const auto& old) { return old.expired(); }),
+                                entry.retired.end());
+            entry.retired.push_back(entry.current);
+            entry.current = std::move(library);
+            entry.loaded = candidate.stamp;
+            reload.ok = true;
+        } else {
+            entry.failed = candidate.stamp;
+        }
+        reload.generation = entry.current->generation;
+        reloads.push_back(std::move(reload));
+    }
+    return reloads;
+}
+
+void StrategyRegistry::watch(std::chrono::milliseconds interval, std::function<void(const Reload&)> onReload) {
+    stopWatching();
+    watch_stop = false;
+    watcher = std::thread([this, interval, onReload = std::move(onReload)]() {
+        std::unique_lock<std::mutex> lock(watch_mutex);
+        while (!watch_cv.wait_for(lock, interval, [this]() { return watch_stop; })) {
+            lock.unlock();
+            for (const Reload& reload : poll()) {
+                if (onReload) onReload(reload);
+            }
+            lock.lock();
+        }
+    });
+}
+
+void StrategyRegistry::stopWatching() {
+    if (!watcher.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex);
+        watch_stop = true;
+    }
+    watch_cv.notify_all();
+    watcher.join();
+}
+
+} // namespace sevens
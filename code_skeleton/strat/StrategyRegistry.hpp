@@ -0,0 +1,109 @@
+#pragma once
+
+#include "PlayerStrategy.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sevens {
+
+/**
+ * Named strategy libraries that can be replaced while games are running.
+ *
+ * Each name maps to a .so path. poll() notices when a file has changed
+ * and loads the new version next to the old one as the next generation.
+ * create() always hands out instances of the newest generation. Every
+ * instance holds a reference to the generation it came from, and a
+ * generation is dlclose()d only when its last instance is gone. So games
+ * that are already running finish on the code they started with.
+ *
+ * dlopen() returns the already-loaded handle for a path it has seen, so
+ * each generation is loaded from a private copy of the file. The copy is
+ * unlinked right after loading (the mapping stays valid). A changed file
+ * is only loaded once it has looked the same on two polls in a row, so a
+ * half-written upload is never opened. If a new version fails to load, or
+ * its createStrategy() fails, the current generation stays in place.
+ */
+class StrategyRegistry {
+public:
+    // Outcome of one reload attempt
+    struct Reload {
+        std::string name;
+        uint64_t generation = 0;  // New generation, or the one kept on failure
+        bool ok = false;
+        std::string error;
+    };
+
+    // Private copies go to cacheDir (default: <tmp>/sevens-strategies)
+    explicit StrategyRegistry(std::string cacheDir = "");
+    ~StrategyRegistry();
+
+    StrategyRegistry(const StrategyRegistry&) = delete;
+    StrategyRegistry& operator=(const StrategyRegistry&) = delete;
+
+    // Load generation 1 of a library; throws std::runtime_error if it does not load
+    void add(const std::string& name, const std::string& path);
+
+    // New instance from the current generation of `name` (thread-safe).
+    // If `generation` is given it receives the generation number.
+    std::shared_ptr<PlayerStrategy> create(const std::string& name, uint64_t* generation = nullptr) const;
+
+    // Current generation of `name` (cheap; for "has it changed?" checks)
+    uint64_t generation(const std::string& name) const;
+    // Generations of `name` still loaded, the current one included
+    size_t liveGenerations(const std::string& name) const;
+    std::vector<std::string> names() const;
+
+    // Check every file once and load the ones that changed
+    std::vector<Reload> poll();
+
+    // Call poll() every `interval` on a background thread; onReload runs on
+    // that thread for each attempt. Replaces any previous watcher.
+    void watch(std::chrono::milliseconds interval, std::function<void(const Reload&)> onReload);
+    void stopWatching();
+
+private:
+    struct Library;
+
+    // Identity of a file version: a rewrite or a rename over it changes it
+    struct FileStamp {
+        int64_t mtime_ns = 0;
+        uint64_t size = 0;
+        uint64_t inode = 0;
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    struct Entry {
+        std::string path;
+        std::shared_ptr<const Library> current;
+        std::vector<std::weak_ptr<const Library>> retired;
+        FileStamp loaded;   // Version behind `current`
+        FileStamp seen;     // Version seen by the last poll
+        FileStamp failed;   // Last version that did not load
+    };
+
+    std::string cache_dir;
+    std::atomic<uint64_t> copies{0};
+
+    mutable std::mutex mutex;
+    std::mutex poll_mutex;  // One poll() at a time
+    std::map<std::string, Entry> entries;
+
+    std::mutex watch_mutex;
+    std::condition_variable watch_cv;
+    bool watch_stop = false;
+    std::thread watcher;
+
+    static bool stampOf(const std::string& path, FileStamp& stamp);
+    std::shared_ptr<const Library> load(const std::string& name, const std::string& path, uint64_t generation);
+};
+
+} // namespace sevens
@@ -48,6 +48,16 @@ public:
         (void)playerID;
     }
     
+    void onGameStart(const GameStartInfo& info) override {
+        // TODO: reset any per-game memory here; the object is reused across games
+        initialize(info.seat);
+    }
+    
+    void onGameEnd(uint64_t finalRank) override {
+        // TODO: learn from the outcome if you need
+        (void)finalRank;
+    }
+    
     std::string getName() const override {
         // TODO: rename to something unique
         return "MyStrategy";
@@ -62,4 +72,9 @@ extern "C" PlayerStrategy* createStrategy() {
     return new StudentStrategy();
 }
 
+// Tells the loader which version of PlayerStrategy this was built against
+extern "C" int strategyAbiVersion() {
+    return kStrategyAbiVersion;
+}
+
 } // namespace sevens
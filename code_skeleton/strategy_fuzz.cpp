@@ -0,0 +1,424 @@
+#include "game/mapper/MyGameMapper.hpp"
+#include "strat/RandomStrategy.hpp"
+#include "strat/StrategyLoader.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace sevens;
+
+/**
+ * Strategy fuzzer: drives a competition .so through many random games and
+ * reports crashes, hangs, exceptions, illegal move indices and slow
+ * decisions before the strategy is let into a tournament.
+ *
+ *   ./strategy_fuzz <strategy.so> [--games N] [--seed S] [--timeout-ms T]
+ *                   [--slow-us U] [--rules file] [--replay G]
+ *
+ * Game g picks its player count (2-8), deal, the fuzzed seat and whether
+ * every seat runs its own instance of the strategy from (seed, g); the other
+ * seats play RandomStrategy, reseeded from (seed, g, seat) every game. After
+ * each game the strategy is also asked to move with an empty hand, which
+ * must return -1.
+ *
+ * The games run in a forked child so a crash or hang cannot take the
+ * harness down: the parent reports the signal (or kills any call into the
+ * strategy, decision, observation or lifecycle hook, that exceeds
+ * --timeout-ms) with the game index, and restarts the child at the next
+ * game. --replay G plays that one game in-process, verbosely, for a
+ * debugger. Exit status is 2 if anything was found.
+ */
+
+namespace {
+
+constexpr int kMaxCases = 8;
+constexpr int kBuckets = 40;
+
+// A recorded failure, for the report
+struct FuzzCase {
+    uint64_t game;
+    uint64_t seat;
+    int64_t index;
+    uint64_t moves;
+};
+
+// Lives in shared memory: written by the child, read by the parent
+struct FuzzShared {
+    std::atomic<uint64_t> game{0};
+    std::atomic<uint64_t> seat{0};
+    std::atomic<uint64_t> games_done{0};
+    std::atomic<uint64_t> decisions{0};
+    std::atomic<int64_t> call_start_ns{0};  // Non-zero while inside a call to the fuzzed strategy
+    char call_name[32] = {};                // That call, for the hang report
+
+    uint64_t illegal = 0;
+    uint64_t empty_failures = 0;
+    uint64_t exceptions = 0;
+    uint64_t slow = 0;
+    uint64_t max_ns = 0;
+    uint64_t histogram[kBuckets] = {};  // Bucket b: latency below 2^b ns
+    FuzzCase illegal_cases[kMaxCases];
+    char first_exception[256] = {};
+};
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Per-game setup derived from (seed, game)
+struct GameSetup {
+    uint64_t numPlayers;
+    uint64_t fuzzSeat;
+    bool everySeat;
+    uint64_t dealSeed;
+
+    GameSetup(uint64_t seed, uint64_t game) {
+        std::mt19937_64 rng(seed ^ (game * 0x9E3779B97F4A7C15ULL));
+        numPlayers = 2 + rng() % 7;
+        fuzzSeat = rng() % numPlayers;
+        everySeat = rng() % 4 == 0;
+        dealSeed = rng();
+    }
+
+    // Seed of the RandomStrategy in `seat` for this game
+    static uint64_t randomSeed(uint64_t seed, uint64_t game, uint64_t seat) {
+        std::mt19937_64 rng(seed ^ (game * 0x9E3779B97F4A7C15ULL) ^ ((seat + 1) * 0xBF58476D1CE4E5B9ULL));
+        return rng();
+    }
+};
+
+// Seat wrapper that checks and times every answer of the fuzzed strategy
+class CheckedSeat : public PlayerStrategy {
+public:
+    CheckedSeat(uint64_t seat, FuzzShared* shared, uint64_t slowNs)
+        : seat(seat), shared(shared), slow_ns(slowNs), random(std::make_shared<RandomStrategy>()) {}
+
+    // Play the fuzzed instance (or RandomStrategy, restarted from randomSeed,
+    // when target is null) next game
+    void use(std::shared_ptr<PlayerStrategy> newTarget, uint64_t randomSeed) {
+        target = std::move(newTarget);
+        active = target ? target.get() : random.get();
+        random->reseed(randomSeed);
+    }
+    bool fuzzing() const { return target != nullptr; }
+
+    void initialize(uint64_t playerID) override {
+        watched("initialize", [&]() { active->initialize(playerID); });
+    }
+    void onGameStart(const GameStartInfo& info) override {
+        watched("onGameStart", [&]() { active->onGameStart(info); });
+    }
+    void onGameEnd(uint64_t finalRank) override {
+        watched("onGameEnd", [&]() { active->onGameEnd(finalRank); });
+    }
+    void observeMove(uint64_t playerID, const Card& playedCard) override {
+        watched("observeMove", [&]() { active->observeMove(playerID, playedCard); });
+    }
+    void observePass(uint64_t playerID) override {
+        watched("observePass", [&]() { active->observePass(playerID); });
+    }
+    std::string getName() const override { return active->getName(); }
+
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override
+    {
+        if (!target) return random->selectCardToPlay(hand, tableLayout);
+
+        int index = -1;
+        const uint64_t elapsed =
+            watched("selectCardToPlay", [&]() { index = target->selectCardToPlay(hand, tableLayout); });
+        shared->decisions.fetch_add(1, std::memory_order_relaxed);
+
+        int bucket = 0;
+        while (bucket < kBuckets - 1 && (1ULL << bucket) <= elapsed) bucket++;
+        shared->histogram[bucket]++;
+        if (elapsed > shared->max_ns) shared->max_ns = elapsed;
+        if (elapsed > slow_ns) shared->slow++;
+
+        if (index < 0 || static_cast<size_t>(index) >= hand.size()) {
+            if (shared->illegal < kMaxCases) {
+                shared->illegal_cases[shared->illegal] =
+                    FuzzCase{shared->game.load(), seat, index, hand.size()};
+            }
+            shared->illegal++;
+        }
+        return index;
+    }
+
+    // The interface contract for a hand with no playable card
+    void checkEmptyHand(const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) {
+        if (!target) return;
+        int index = 0;
+        watched("selectCardToPlay", [&]() { index = target->selectCardToPlay({}, tableLayout); });
+        if (index != -1) shared->empty_failures++;
+    }
+
+private:
+    uint64_t seat;
+    FuzzShared* shared;
+    uint64_t slow_ns;
+    std::shared_ptr<RandomStrategy> random;
+    std::shared_ptr<PlayerStrategy> target;
+    PlayerStrategy* active = nullptr;
+
+    // guard() a call into the active strategy; while the fuzzed one runs, the
+    // parent can see the call and kill it on timeout. Returns its duration in ns.
+    template <typename Call>
+    uint64_t watched(const char* name, Call call) {
+        if (!target) {
+            guard(call);
+            return 0;
+        }
+        shared->seat.store(seat, std::memory_order_relaxed);
+        std::strncpy(shared->call_name, name, sizeof(shared->call_name) - 1);
+        const int64_t start = nowNs();
+        shared->call_start_ns.store(start, std::memory_order_release);
+        guard(call);
+        const uint64_t elapsed = static_cast<uint64_t>(nowNs() - start);
+        shared->call_start_ns.store(0, std::memory_order_release);
+        return elapsed;
+    }
+
+    template <typename Call>
+    void guard(Call call) {
+        try {
+            call();
+        } catch (const std::exception& e) {
+            if (shared->exceptions++ == 0) {
+                std::strncpy(shared->first_exception, e.what(), sizeof(shared->first_exception) - 1);
+            }
+        } catch (...) {
+            if (shared->exceptions++ == 0) {
+                std::strncpy(shared->first_exception, "non-std exception", sizeof(shared->first_exception) - 1);
+            }
+        }
+    }
+};
+
+// Play games [first, last) of the run; returns normally only if all finished
+void fuzzGames(const std::string& library, const std::string& rulesPath, uint64_t seed, uint64_t first,
+               uint64_t last, uint64_t slowNs, FuzzShared* shared, bool verbose) {
+    MyGameMapper mapper;
+    mapper.read_cards("");
+    mapper.read_game(rulesPath);
+    mapper.setIllegalMovePolicy(IllegalMovePolicy::PlayFirst);
+    mapper.setForcedMoveShortcut(false);  // Forced positions are inputs too
+
+    // One wrapper per possible seat and one strategy instance per seat
+    std::vector<std::shared_ptr<CheckedSeat>> seats;
+    std::vector<std::shared_ptr<PlayerStrategy>> instances;
+    for (uint64_t seat = 0; seat < GameRules::kMaxPlayers; seat++) {
+        seats.push_back(std::make_shared<CheckedSeat>(seat, shared, slowNs));
+        instances.push_back(StrategyLoader::loadFromLibrary(library));
+        mapper.registerStrategy(seat, seats.back());
+    }
+
+    for (uint64_t game = first; game < last; game++) {
+        shared->game.store(game);
+        const GameSetup setup(seed, game);
+        for (uint64_t seat = 0; seat < seats.size(); seat++) {
+            seats[seat]->use(setup.everySeat || seat == setup.fuzzSeat ? instances[seat] : nullptr,
+                             GameSetup::randomSeed(seed, game, seat));
+        }
+        mapper.setDealSeed(setup.dealSeed);
+        if (verbose) {
+            mapper.compute_and_display_game(setup.numPlayers);
+        } else {
+            mapper.compute_game_progress(setup.numPlayers);
+        }
+        for (uint64_t seat = 0; seat < setup.numPlayers; seat++) {
+            seats[seat]->checkEmptyHand(mapper.getTableLayout());
+        }
+        shared->games_done.fetch_add(1);
+    }
+}
+
+const char* describeSignal(int sig) {
+    const char* name = strsignal(sig);
+    return name ? name : "unknown signal";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <strategy.so> [--games N] [--seed S] [--timeout-ms T]"
+                  << " [--slow-us U] [--rules file] [--replay G]\n";
+        return 1;
+    }
+    std::string library = argv[1];
+    uint64_t games = 200000;
+    uint64_t seed = 1;
+    uint64_t timeoutMs = 2000;
+    uint64_t slowUs = 1000;
+    std::string rulesPath;
+    int64_t replay = -1;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--games") games = std::stoull(argv[++i]);
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else if (arg == "--timeout-ms") timeoutMs = std::stoull(argv[++i]);
+            else if (arg == "--slow-us") slowUs = std::stoull(argv[++i]);
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else if (arg == "--replay") replay = std::stoll(argv[++i]);
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    if (library.find('/') == std::string::npos) library = "./" + library;
+
+    void* memory = mmap(nullptr, sizeof(FuzzShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "[strategy_fuzz] mmap failed: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    FuzzShared* shared = new (memory) FuzzShared();
+
+    if (replay >= 0) {
+        try {
+            const GameSetup setup(seed, replay);
+            std::cout << "Replaying game " << replay << ": " << setup.numPlayers << " players, fuzzed seat "
+                      << (setup.everySeat ? std::string("all") : std::to_string(setup.fuzzSeat)) << "\n";
+            fuzzGames(library, rulesPath, seed, replay, replay + 1, slowUs * 1000, shared, true);
+        } catch (const std::exception& e) {
+            std::cerr << "[strategy_fuzz] " << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "Illegal moves: " << shared->illegal << ", exceptions: " << shared->exceptions << "\n";
+        return shared->illegal || shared->exceptions ? 2 : 0;
+    }
+
+    struct Fault {
+        std::string what;
+        uint64_t game;
+        uint64_t seat;
+    };
+    std::vector<Fault> faults;
+    auto start = std::chrono::steady_clock::now();
+    auto lastReport = start;
+    uint64_t next = 0;
+
+    while (next < games) {
+        std::cout.flush();
+        pid_t child = fork();
+        if (child < 0) {
+            std::cerr << "[strategy_fuzz] fork failed: " << std::strerror(errno) << "\n";
+            return 1;
+        }
+        if (child == 0) {
+            try {
+                fuzzGames(library, rulesPath, seed, next, games, slowUs * 1000, shared, false);
+            } catch (const std::exception& e) {
+                std::cerr << "[strategy_fuzz] " << e.what() << "\n";
+                _exit(3);
+            }
+            _exit(0);
+        }
+
+        // Watch the child: reap it, or kill it if one decision takes too long
+        int status = 0;
+        while (true) {
+            pid_t done = waitpid(child, &status, WNOHANG);
+            if (done == child) break;
+            const int64_t callStart = shared->call_start_ns.load(std::memory_order_acquire);
+            if (callStart != 0 && nowNs() - callStart > static_cast<int64_t>(timeoutMs) * 1000000) {
+                kill(child, SIGKILL);
+                waitpid(child, &status, 0);
+                status = -1;
+                break;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastReport > std::chrono::seconds(5)) {
+                lastReport = now;
+                std::cout << "  " << shared->games_done.load() << " games, " << shared->decisions.load()
+                          << " decisions" << std::endl;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        const uint64_t game = shared->game.load();
+        if (status == -1) {
+            faults.push_back({"hang (" + std::string(shared->call_name) + " over " + std::to_string(timeoutMs) + " ms)",
+                              game, shared->seat.load()});
+            shared->call_start_ns.store(0);
+        } else if (WIFSIGNALED(status)) {
+            faults.push_back({std::string("crash: ") + describeSignal(WTERMSIG(status)), game, shared->seat.load()});
+            shared->call_start_ns.store(0);
+        } else if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+            std::cerr << "[strategy_fuzz] harness failed in game " << game << "\n";
+            return 1;
+        } else {
+            break;
+        }
+        if (faults.size() >= 20) {
+            std::cout << "Stopping after " << faults.size() << " crashes/hangs\n";
+            break;
+        }
+        next = game + 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const uint64_t decisions = shared->decisions.load();
+    std::cout << "\n=== Fuzz results: " << shared->games_done.load() << " games, " << decisions << " decisions in "
+              << seconds << " s ===\n";
+    for (const Fault& fault : faults) {
+        std::cout << fault.what << " in game " << fault.game << " (seat " << fault.seat << ", replay with --seed "
+                  << seed << " --replay " << fault.game << ")\n";
+    }
+    std::cout << "Illegal move indices: " << shared->illegal << "\n";
+    for (int c = 0; c < kMaxCases && c < static_cast<int>(shared->illegal); c++) {
+        const FuzzCase& bad = shared->illegal_cases[c];
+        std::cout << "  game " << bad.game << ", seat " << bad.seat << ": returned " << bad.index << " with "
+                  << bad.moves << " valid moves\n";
+    }
+    std::cout << "Empty-hand answers other than -1: " << shared->empty_failures << "\n";
+    std::cout << "Exceptions: " << shared->exceptions;
+    if (shared->exceptions) std::cout << " (first: " << shared->first_exception << ")";
+    std::cout << "\n";
+
+    // Latency percentiles from the power-of-two histogram (upper bounds)
+    auto percentile = [&](double q) {
+        uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; b++) {
+            seen += shared->histogram[b];
+            if (seen >= q * decisions) return 1ULL << b;
+        }
+        return 1ULL << (kBuckets - 1);
+    };
+    if (decisions > 0) {
+        std::cout << "Decision latency: p50 < " << percentile(0.5) / 1000.0 << " us, p99 < "
+                  << percentile(0.99) / 1000.0 << " us, max " << shared->max_ns / 1000.0 << " us; "
+                  << shared->slow << " over " << slowUs << " us\n";
+    }
+
+    const bool clean = faults.empty() && shared->illegal == 0 && shared->empty_failures == 0 &&
+                       shared->exceptions == 0;
+    std::cout << (clean ? "No problems found.\n" : "Problems found.\n");
+    return clean ? 0 : 2;
+}
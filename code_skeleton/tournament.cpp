@@ -0,0 +1,273 @@
+#include "game/mapper/MyGameMapper.hpp"
+#include "game/metrics/MetricsExporter.hpp"
+#include "game/metrics/RunMetrics.hpp"
+#include "strat/StrategyRegistry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Long-running tournament between strategy libraries that may be replaced
+ * while it runs.
+ *
+ *   ./tournament <a.so> <b.so> ... [--players N] [--threads T] [--games N]
+ *                [--poll-ms P] [--report-every N] [--rules file] [--seed S]
+ *                [--metrics-file path] [--metrics-port P] [--metrics-every S]
+ *
+ * Game g seats library (g + s) mod k at seat s. Overwrite or rename a new
+ * build over one of the .so files and the tournament picks it up within
+ * two polls: the next games use the new generation, games already running
+ * finish on the old one, and instances of the other libraries (and their
+ * warm state) are kept. Standings are kept per (library, generation).
+ * --games 0 (the default) runs until interrupted.
+ *
+ * --metrics-file / --metrics-port export Prometheus metrics (see
+ * RunMetrics) with one strategy label per "library@generation".
+ */
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+struct Standing {
+    uint64_t games = 0;
+    uint64_t wins = 0;
+    uint64_t rankSum = 0;
+};
+
+// An instance a worker keeps across games until its library is reloaded
+struct Held {
+    uint64_t generation = 0;
+    std::shared_ptr<PlayerStrategy> strategy;
+    RunMetrics::StrategyMetrics* metrics = nullptr;
+};
+
+// Seat that forwards to whichever held instance sits there this game
+class TournamentSeat : public PlayerStrategy {
+public:
+    // timing, if set, receives every decision's latency
+    void use(PlayerStrategy* strategy, LatencyHistogram* timing) {
+        active = strategy;
+        histogram = timing;
+    }
+
+    void initialize(uint64_t playerID) override { active->initialize(playerID); }
+    void onGameStart(const GameStartInfo& info) override { active->onGameStart(info); }
+    void onGameEnd(uint64_t finalRank) override { active->onGameEnd(finalRank); }
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override
+    {
+        if (!histogram) return active->selectCardToPlay(hand, tableLayout);
+        const auto start = std::chrono::steady_clock::now();
+        const int index = active->selectCardToPlay(hand, tableLayout);
+        histogram->observe(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+        return index;
+    }
+    void observeMove(uint64_t playerID, const Card& playedCard) override { active->observeMove(playerID, playedCard); }
+    void observePass(uint64_t playerID) override { active->observePass(playerID); }
+    bool wantsObservations() const override { return active->wantsObservations(); }
+    std::string getName() const override { return active->getName(); }
+
+private:
+    PlayerStrategy* active = nullptr;
+    LatencyHistogram* histogram = nullptr;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> libraries;
+    uint64_t numPlayers = 4;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t games = 0;
+    uint64_t pollMs = 1000;
+    uint64_t reportEvery = 10000;
+    std::string rulesPath;
+    uint64_t seed = 1;
+    std::string metricsFile;
+    int metricsPort = -1;
+    uint64_t metricsEvery = 10;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            libraries.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--threads") threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            else if (arg == "--games") games = std::stoull(argv[++i]);
+            else if (arg == "--poll-ms") pollMs = std::stoull(argv[++i]);
+            else if (arg == "--report-every") reportEvery = std::stoull(argv[++i]);
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else if (arg == "--metrics-file") metricsFile = argv[++i];
+            else if (arg == "--metrics-port") metricsPort = std::stoi(argv[++i]);
+            else if (arg == "--metrics-every") metricsEvery = std::stoull(argv[++i]);
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    if (libraries.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <a.so> <b.so> ... [--players N] [--threads T] [--games N]"
+                  << " [--poll-ms P] [--report-every N] [--rules file] [--seed S]"
+                  << " [--metrics-file path] [--metrics-port P] [--metrics-every S]\n";
+        return 1;
+    }
+
+    try {
+        if (threads == 0) threads = 1;
+        if (reportEvery == 0) reportEvery = 10000;
+
+        MyGameMapper prototype;
+        prototype.read_cards("");
+        prototype.read_game(rulesPath);
+        prototype.getRules().validate(numPlayers);
+
+        StrategyRegistry registry;
+        for (const std::string& path : libraries) registry.add(path, path);
+
+        std::mutex mutex;  // Guards standings and the console
+        std::map<std::pair<std::string, uint64_t>, Standing> standings;
+
+        MetricsRegistry metricsRegistry;
+        std::unique_ptr<RunMetrics> metrics;
+        std::unique_ptr<MetricsExporter> exporter;
+        if (!metricsFile.empty() || metricsPort >= 0) {
+            metrics = std::make_unique<RunMetrics>(metricsRegistry);
+            exporter = std::make_unique<MetricsExporter>(
+                metricsRegistry, metricsFile, std::chrono::seconds(std::max<uint64_t>(metricsEvery, 1)), metricsPort);
+        }
+
+        auto report = [&](uint64_t played) {
+            std::cout << "\n=== Standings after " << played << " games ===\n";
+            for (const auto& [key, standing] : standings) {
+                std::cout << key.first << " (generation " << key.second << "): " << standing.games
+                          << " games, win rate " << std::fixed << std::setprecision(4)
+                          << static_cast<double>(standing.wins) / standing.games << ", average rank "
+                          << static_cast<double>(standing.rankSum) / standing.games << std::defaultfloat
+                          << "\n";
+            }
+            for (const std::string& path : libraries) {
+                std::cout << path << ": " << registry.liveGenerations(path) << " generation(s) loaded\n";
+            }
+            std::cout << std::flush;
+        };
+
+        registry.watch(std::chrono::milliseconds(pollMs), [&](const StrategyRegistry::Reload& reload) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (reload.ok) {
+                std::cout << "[tournament] Reloaded " << reload.name << " as generation " << reload.generation
+                          << std::endl;
+            } else {
+                std::cout << "[tournament] Kept generation " << reload.generation << " of " << reload.name
+                          << ": " << reload.error << std::endl;
+            }
+        });
+        std::signal(SIGINT, [](int) { interrupted = true; });
+
+        std::cout << "Tournament of " << libraries.size() << " libraries, " << numPlayers << " players, "
+                  << threads << " threads" << std::endl;
+
+        std::atomic<uint64_t> next{0};
+        std::atomic<uint64_t> finished{0};
+        std::exception_ptr failure;
+
+        auto work = [&]() {
+            try {
+                MyGameMapper mapper = prototype;
+                std::vector<std::shared_ptr<TournamentSeat>> seats;
+                for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                    seats.push_back(std::make_shared<TournamentSeat>());
+                    mapper.registerStrategy(seat, seats.back());
+                }
+                // held[library][copy]: copy c is the c-th seat of that library in a game
+                std::vector<std::vector<Held>> held(libraries.size());
+                std::vector<uint64_t> seatGeneration(numPlayers);
+                std::vector<RunMetrics::StrategyMetrics*> seatMetrics(numPlayers);
+
+                for (uint64_t game = next++; !interrupted && (games == 0 || game < games); game = next++) {
+                    std::vector<size_t> copies(libraries.size(), 0);
+                    for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                        const size_t library = (game + seat) % libraries.size();
+                        const size_t copy = copies[library]++;
+                        if (held[library].size() <= copy) held[library].resize(copy + 1);
+                        Held& instance = held[library][copy];
+                        if (!instance.strategy || instance.generation != registry.generation(libraries[library])) {
+                            instance.strategy = registry.create(libraries[library], &instance.generation);
+                            if (metrics) {
+                                instance.metrics = &metrics->strategy(libraries[library] + "@" +
+                                                                      std::to_string(instance.generation));
+                            }
+                        }
+                        seats[seat]->use(instance.strategy.get(),
+                                         instance.metrics ? &instance.metrics->decisions : nullptr);
+                        seatMetrics[seat] = instance.metrics;
+                        seatGeneration[seat] = instance.generation;
+                    }
+
+                    mapper.setDealSeed(seed * 0x9E3779B97F4A7C15ULL + game);
+                    const auto results = mapper.compute_game_progress(numPlayers);
+                    if (metrics) {
+                        for (const auto& result : results) seatMetrics[result.first]->record(result.second);
+                        metrics->gameFinished();
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for (const auto& result : results) {
+                        const std::string& library = libraries[(game + result.first) % libraries.size()];
+                        Standing& standing = standings[{library, seatGeneration[result.first]}];
+                        standing.games++;
+                        standing.rankSum += result.second;
+                        if (result.second == 1) standing.wins++;
+                    }
+                    const uint64_t played = ++finished;
+                    if (played % reportEvery == 0) report(played);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) failure = std::current_exception();
+                interrupted = true;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) workers.emplace_back(work);
+        for (auto& worker : workers) worker.join();
+        registry.stopWatching();
+        if (failure) std::rethrow_exception(failure);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (finished % reportEvery != 0) report(finished);
+    } catch (const std::exception& e) {
+        std::cerr << "[tournament] " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
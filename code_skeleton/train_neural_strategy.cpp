@@ -0,0 +1,248 @@
+#include "strat/ActorCritic.hpp"
+#include "strat/NeuralStrategy.hpp"
+#include "strat/GreedyStrategy.hpp"
+#include "game/mapper/MyGameMapper.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sevens;
+
+/**
+ * Self-play actor-critic trainer for NeuralStrategy.
+ *
+ *   ./train_neural_strategy [--iterations N] [--games G] [--threads T]
+ *                           [--players P] [--lr L] [--gamma G] [--lambda L]
+ *                           [--entropy E] [--value-coef C]
+ *                           [--league-size K] [--league-every N] [--league-prob P]
+ *                           [--seed S] [--init weights.bin] [--out weights.bin]
+ *                           [--eval-every N] [--rules file]
+ *
+ * Each iteration plays G games spread over T environment threads (each with
+ * its own mapper and seats), then does one ActorCriticUpdater step on every
+ * learner episode of the batch, again on T threads.
+ *
+ * Opponents come from a league: every --league-every iterations a frozen
+ * copy of the net is added (at most --league-size, oldest dropped first),
+ * and each non-learner seat plays a random league member with probability
+ * --league-prob, the current net otherwise. One seat per game, rotating, is
+ * always the learner. Every --eval-every iterations the weights are saved
+ * and the greedy net (seat 0) is measured against GreedyStrategy on fixed deals.
+ */
+
+namespace {
+
+// Seat that plays either the learner or the frozen league opponent, chosen per game
+class LeagueSeat : public PlayerStrategy {
+public:
+    LeagueSeat(std::shared_ptr<NeuralStrategy> learner, std::shared_ptr<NeuralStrategy> frozen)
+        : learner(std::move(learner)), frozen(std::move(frozen)), active(this->learner.get()) {}
+
+    void useLearner() { active = learner.get(); }
+    void useFrozen(std::shared_ptr<const PolicyValueNet> net) {
+        frozen->setNet(std::move(net));
+        active = frozen.get();
+    }
+
+    void initialize(uint64_t playerID) override { active->initialize(playerID); }
+    void onGameStart(const GameStartInfo& info) override { active->onGameStart(info); }
+    void onGameEnd(uint64_t finalRank) override { active->onGameEnd(finalRank); }
+    int selectCardToPlay(
+        const std::vector<Card>& hand,
+        const std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>& tableLayout) override
+    {
+        return active->selectCardToPlay(hand, tableLayout);
+    }
+    void observeMove(uint64_t playerID, const Card& playedCard) override { active->observeMove(playerID, playedCard); }
+    void observePass(uint64_t playerID) override { active->observePass(playerID); }
+    std::string getName() const override { return active->getName(); }
+
+private:
+    std::shared_ptr<NeuralStrategy> learner;
+    std::shared_ptr<NeuralStrategy> frozen;
+    NeuralStrategy* active;
+};
+
+// One environment thread: its own table, seats and episode buffer
+struct Environment {
+    MyGameMapper mapper;
+    std::vector<std::shared_ptr<LeagueSeat>> seats;
+    std::shared_ptr<std::vector<PolicyEpisode>> episodes = std::make_shared<std::vector<PolicyEpisode>>();
+    std::mt19937_64 rng;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t iterations = 2000;
+    uint64_t gamesPerIteration = 256;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t numPlayers = 4;
+    ActorCriticConfig config;
+    uint64_t leagueSize = 16;
+    uint64_t leagueEvery = 50;
+    double leagueProb = 0.5;
+    uint64_t seed = 1;
+    std::string initPath;
+    std::string outPath = "neural.bin";
+    uint64_t evalEvery = 100;
+    std::string rulesPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--iterations") iterations = std::stoull(argv[++i]);
+            else if (arg == "--games") gamesPerIteration = std::stoull(argv[++i]);
+            else if (arg == "--threads") threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            else if (arg == "--players") numPlayers = std::stoull(argv[++i]);
+            else if (arg == "--lr") config.learningRate = std::stof(argv[++i]);
+            else if (arg == "--gamma") config.gamma = std::stof(argv[++i]);
+            else if (arg == "--lambda") config.lambda = std::stof(argv[++i]);
+            else if (arg == "--entropy") config.entropyCoef = std::stof(argv[++i]);
+            else if (arg == "--value-coef") config.valueCoef = std::stof(argv[++i]);
+            else if (arg == "--league-size") leagueSize = std::stoull(argv[++i]);
+            else if (arg == "--league-every") leagueEvery = std::stoull(argv[++i]);
+            else if (arg == "--league-prob") leagueProb = std::stod(argv[++i]);
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else if (arg == "--init") initPath = argv[++i];
+            else if (arg == "--out") outPath = argv[++i];
+            else if (arg == "--eval-every") evalEvery = std::stoull(argv[++i]);
+            else if (arg == "--rules") rulesPath = argv[++i];
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        if (threads == 0) threads = 1;
+        if (leagueEvery == 0) leagueEvery = 1;
+        if (evalEvery == 0) evalEvery = iterations;
+        config.threads = threads;
+
+        auto net = initPath.empty() ? std::make_shared<PolicyValueNet>(seed)
+                                    : std::make_shared<PolicyValueNet>(initPath);
+        ActorCriticUpdater updater(config);
+        std::vector<std::shared_ptr<const PolicyValueNet>> league;
+
+        MyGameMapper prototype;
+        prototype.read_cards("");
+        prototype.read_game(rulesPath);
+
+        std::vector<std::unique_ptr<Environment>> environments;
+        for (unsigned t = 0; t < threads; t++) {
+            auto env = std::make_unique<Environment>();
+            env->mapper = prototype;
+            env->rng.seed(seed * 0x9E3779B97F4A7C15ULL + t);
+            for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                auto learner = std::make_shared<NeuralStrategy>(net, prototype.getRules());
+                learner->setTraining(env->episodes, env->rng());
+                auto frozen = std::make_shared<NeuralStrategy>(net, prototype.getRules());
+                env->seats.push_back(std::make_shared<LeagueSeat>(learner, frozen));
+                env->mapper.registerStrategy(seat, env->seats.back());
+            }
+            environments.push_back(std::move(env));
+        }
+
+        // Evaluation table: the greedy net against the greedy heuristic
+        MyGameMapper evaluation = prototype;
+        evaluation.registerStrategy(0, std::make_shared<NeuralStrategy>(net, prototype.getRules()));
+        auto greedy = std::make_shared<GreedyStrategy>();
+        for (uint64_t seat = 1; seat < numPlayers; seat++) evaluation.registerStrategy(seat, greedy);
+
+        auto evaluate = [&]() {
+            const uint64_t games = 2000;
+            uint64_t wins = 0, rankSum = 0;
+            for (uint64_t game = 0; game < games; game++) {
+                evaluation.setDealSeed(0x5EED0000 + game);
+                for (const auto& result : evaluation.compute_game_progress(numPlayers)) {
+                    if (result.first != 0) continue;
+                    rankSum += result.second;
+                    if (result.second == 1) wins++;
+                }
+            }
+            std::cout << "  vs greedy: win rate " << static_cast<double>(wins) / games
+                      << ", average rank " << static_cast<double>(rankSum) / games << std::endl;
+        };
+
+        // Play games [first, first + count) of the run in one environment
+        auto play = [&](Environment& env, uint64_t first, uint64_t count) {
+            std::uniform_real_distribution<double> coin(0.0, 1.0);
+            for (uint64_t game = first; game < first + count; game++) {
+                const uint64_t learnerSeat = game % numPlayers;
+                for (uint64_t seat = 0; seat < numPlayers; seat++) {
+                    if (seat != learnerSeat && !league.empty() && coin(env.rng) < leagueProb) {
+                        std::uniform_int_distribution<size_t> pick(0, league.size() - 1);
+                        env.seats[seat]->useFrozen(league[pick(env.rng)]);
+                    } else {
+                        env.seats[seat]->useLearner();
+                    }
+                }
+                env.mapper.setDealSeed(seed * 0xD1B54A32D192ED03ULL + game);
+                env.mapper.compute_game_progress(numPlayers);
+            }
+        };
+
+        std::cout << "Training " << iterations << " iterations of " << gamesPerIteration
+                  << " games on " << threads << " threads, " << numPlayers << " players" << std::endl;
+        evaluate();
+        auto start = std::chrono::steady_clock::now();
+        std::vector<PolicyEpisode> batch;
+        ActorCriticStats stats;
+        for (uint64_t iteration = 1; iteration <= iterations; iteration++) {
+            // Rollouts: every environment plays its share against the current net and league
+            const uint64_t firstGame = (iteration - 1) * gamesPerIteration;
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                const uint64_t begin = gamesPerIteration * t / threads;
+                const uint64_t end = gamesPerIteration * (t + 1) / threads;
+                workers.emplace_back(play, std::ref(*environments[t]), firstGame + begin, end - begin);
+            }
+            for (auto& worker : workers) worker.join();
+
+            batch.clear();
+            for (auto& env : environments) {
+                for (auto& episode : *env->episodes) batch.push_back(std::move(episode));
+                env->episodes->clear();
+            }
+            stats = updater.update(*net, batch);
+
+            if (iteration % leagueEvery == 0) {
+                league.push_back(std::make_shared<const PolicyValueNet>(*net));
+                if (league.size() > leagueSize) league.erase(league.begin());
+            }
+
+            if (iteration % evalEvery == 0 || iteration == iterations) {
+                net->save(outPath);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << "Iteration " << iteration << " ("
+                          << static_cast<uint64_t>(iteration * gamesPerIteration / seconds) << " games/sec)"
+                          << std::fixed << std::setprecision(4)
+                          << ", value loss " << stats.valueLoss << ", entropy " << stats.entropy
+                          << std::defaultfloat << ", league " << league.size()
+                          << ", saved " << outPath << std::endl;
+                evaluate();
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[train_neural_strategy] " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
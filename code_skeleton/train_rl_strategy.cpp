@@ -1,73 +1,215 @@
 #include "strat/RLStrategy.hpp"
+#include "strat/Checkpoint.hpp"
 #include "game/mapper/MyGameMapper.hpp"
+#include "game/metrics/MetricsExporter.hpp"
+#include "game/metrics/RunMetrics.hpp"
 #include "strat/RandomStrategy.hpp"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <string>
 #include <chrono>
+#include <sstream>
+#include <stdexcept>
 #include <thread>
 
 using namespace sevens;
 
-int main() {
-    // Create our RL strategy
-    auto rlStrategy = std::make_shared<RLStrategy>();
+/**
+ *   ./train_rl_strategy [--config rl.cfg] [--episodes N] [--seed S]
+ *                       [--checkpoint-dir dir] [--checkpoint-every N] [--keep K]
+ *                       [--resume latest|none|file.ckpt]
+ *                       [--metrics-file path] [--metrics-port P] [--metrics-every S]
+ *
+ * Hyperparameters and their decay schedules come from the config file
+ * (see RLConfig); without one the defaults are used.
+ *
+ * Checkpoints hold the agent (Q-table, RNG, episode count), the config and
+ * the run's seed, win count and episode. They are written atomically on a
+ * background thread and only the newest --keep are kept. By default a run
+ * resumes from the newest valid checkpoint in --checkpoint-dir; deals and
+ * opponent moves are derived from the seed and episode number, so a resumed
+ * run continues exactly as the uninterrupted one would have.
+ *
+ * --metrics-file / --metrics-port export Prometheus metrics while training
+ * (see RunMetrics), plus the agent's current epsilon and alpha, the episode
+ * and the checkpoints written.
+ */
+
+int main(int argc, char* argv[]) {
+    std::string configPath;
     
     // Number of training episodes
-    const int EPISODES = 1000000;
-    
-    // Create strategies for other players
-    auto randomStrategy = std::make_shared<RandomStrategy>();
+    uint64_t episodes = 1000000;
+    uint64_t seed = 0;
+    std::string checkpointDir = "checkpoints";
+    uint64_t checkpointEvery = 10000;
+    uint64_t keep = 5;
+    std::string resume = "latest";
+    std::string metricsFile;
+    int metricsPort = -1;
+    uint64_t metricsEvery = 10;
     
-    std::cout << "Starting training for " << EPISODES << " episodes..." << std::endl;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        try {
+            if (arg == "--config") configPath = argv[++i];
+            else if (arg == "--episodes") episodes = std::stoull(argv[++i]);
+            else if (arg == "--seed") seed = std::stoull(argv[++i]);
+            else if (arg == "--checkpoint-dir") checkpointDir = argv[++i];
+            else if (arg == "--checkpoint-every") checkpointEvery = std::stoull(argv[++i]);
+            else if (arg == "--keep") keep = std::stoull(argv[++i]);
+            else if (arg == "--resume") resume = argv[++i];
+            else if (arg == "--metrics-file") metricsFile = argv[++i];
+            else if (arg == "--metrics-port") metricsPort = std::stoi(argv[++i]);
+            else if (arg == "--metrics-every") metricsEvery = std::stoull(argv[++i]);
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {
+            std::cerr << "Bad value for " << arg << ": " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    if (checkpointEvery == 0) checkpointEvery = episodes;
     
-    // Track win rate over time
-    int wins = 0;
+    std::shared_ptr<RLStrategy> rlStrategy;
+    auto randomStrategy = std::make_shared<RandomStrategy>();
     
-    for (int episode = 0; episode < EPISODES; ++episode) {
-        // Create game mapper
-        auto gameMapper = std::make_unique<MyGameMapper>();
+    try {
+        RLConfig config;
+        if (!configPath.empty()) config = RLConfig::load(configPath);
         
-        // Initialize cards and game state
-        gameMapper->read_cards("");
-        gameMapper->read_game("");
+        // Pick up where the last run stopped
+        std::string resumePath = resume == "latest" ? CheckpointWriter::findLatest(checkpointDir, "rl")
+                               : resume == "none" ? std::string() : resume;
+        Checkpoint restored;
+        uint64_t firstEpisode = 0;
+        uint64_t wins = 0;
+        if (!resumePath.empty()) {
+            restored = Checkpoint::read(resumePath);
+            if (configPath.empty() && restored.has("config")) {
+                config = RLConfig::parse(restored.get("config"), resumePath);
+            }
+            std::istringstream trainer(restored.get("trainer"));
+            if (!(trainer >> firstEpisode >> wins >> seed)) {
+                throw std::runtime_error("Malformed trainer state in " + resumePath);
+            }
+        } else if (seed == 0) {
+            seed = std::chrono::system_clock::now().time_since_epoch().count();
+        }
         
-        // Register strategies
-        gameMapper->registerStrategy(0, rlStrategy);  // RL agent
-        gameMapper->registerStrategy(1, randomStrategy);
-        gameMapper->registerStrategy(2, randomStrategy);
-        gameMapper->registerStrategy(3, randomStrategy);
+        // Create our RL strategy (its exploration RNG follows the run seed too)
+        if (config.seed == 0) config.seed = seed;
+        rlStrategy = std::make_shared<RLStrategy>(config);
+        if (!resumePath.empty()) {
+            rlStrategy->loadState(restored.get("rl"));
+            std::cout << "Resuming from " << resumePath << " at episode " << firstEpisode << std::endl;
+        }
         
-        // Run simulation silently
-        auto results = gameMapper->compute_game_progress(4);
+        std::cout << "Starting training for " << episodes << " episodes..." << std::endl;
         
-        // Check if RL agent won
-        for (const auto& result : results) {
-            if (result.first == 0 && result.second == 1) {
-                wins++;
-                break;
-            }
+        // One mapper for the whole run: strategies get onGameStart/onGameEnd
+        // per episode, so nothing has to be rebuilt between games
+        auto trainingMapper = std::make_unique<MyGameMapper>();
+        trainingMapper->read_cards("");
+        trainingMapper->read_game("");
+        
+        MetricsRegistry registry;
+        std::unique_ptr<RunMetrics> metrics;
+        RunMetrics::StrategyMetrics* agentMetrics = nullptr;
+        RunMetrics::StrategyMetrics* randomMetrics = nullptr;
+        Gauge* episodeGauge = nullptr;
+        Gauge* epsilonGauge = nullptr;
+        Gauge* alphaGauge = nullptr;
+        std::shared_ptr<PlayerStrategy> agentSeat = rlStrategy;
+        std::shared_ptr<PlayerStrategy> randomSeat = randomStrategy;
+        if (!metricsFile.empty() || metricsPort >= 0) {
+            metrics = std::make_unique<RunMetrics>(registry);
+            agentMetrics = &metrics->strategy("rl");
+            randomMetrics = &metrics->strategy("random");
+            agentSeat = std::make_shared<TimedStrategy>(rlStrategy, agentMetrics->decisions);
+            randomSeat = std::make_shared<TimedStrategy>(randomStrategy, randomMetrics->decisions);
+            episodeGauge = &registry.gauge("sevens_rl_episode", "Episodes completed");
+            epsilonGauge = &registry.gauge("sevens_rl_epsilon", "Current exploration rate");
+            alphaGauge = &registry.gauge("sevens_rl_alpha", "Current learning rate");
+        }
+        
+        trainingMapper->registerStrategy(0, agentSeat);  // RL agent
+        trainingMapper->registerStrategy(1, randomSeat);
+        trainingMapper->registerStrategy(2, randomSeat);
+        trainingMapper->registerStrategy(3, randomSeat);
+        
+        CheckpointWriter writer(checkpointDir, "rl", keep);
+        std::unique_ptr<MetricsExporter> exporter;
+        if (metrics) {
+            Gauge& checkpoints = registry.gauge("sevens_checkpoints_written", "Checkpoints on disk so far");
+            registry.addCollector([&writer, &checkpoints]() { checkpoints.set(static_cast<double>(writer.written())); });
+            exporter = std::make_unique<MetricsExporter>(
+                registry, metricsFile, std::chrono::seconds(std::max<uint64_t>(metricsEvery, 1)), metricsPort);
         }
         
-        // Decrease exploration rate over time
-        if (episode % 1000 == 0 && episode > 0) {
-            // Save model periodically
-            rlStrategy->saveModel("rl_model_" + std::to_string(episode) + ".dat");
+        for (uint64_t episode = firstEpisode; episode < episodes; ++episode) {
+            // Deal and opponents depend only on (seed, episode)
+            trainingMapper->setDealSeed(seed * 0x9E3779B97F4A7C15ULL + episode);
+            randomStrategy->reseed(seed ^ (episode * 0xD1B54A32D192ED03ULL));
             
-            // Print progress
-            double win_rate = static_cast<double>(wins) / episode;
-            std::cout << "Episode " << episode << ", Win rate: " << win_rate << std::endl;
+            // Run simulation silently
+            auto results = trainingMapper->compute_game_progress(4);
+            
+            // Check if RL agent won
+            for (const auto& result : results) {
+                if (result.first == 0 && result.second == 1) {
+                    wins++;
+                    break;
+                }
+            }
+            if (metrics) {
+                for (const auto& result : results) {
+                    (result.first == 0 ? agentMetrics : randomMetrics)->record(result.second);
+                }
+                metrics->gameFinished();
+                episodeGauge->set(static_cast<double>(rlStrategy->getEpisodes()));
+                epsilonGauge->set(rlStrategy->getEpsilon());
+                alphaGauge->set(rlStrategy->getAlpha());
+            }
+            
+            // Epsilon and alpha follow the config's schedules inside RLStrategy
+            const uint64_t completed = episode + 1;
+            if (completed % checkpointEvery == 0 || completed == episodes) {
+                // Hand the snapshot to the writer thread and keep training
+                Checkpoint checkpoint;
+                checkpoint.put("rl", rlStrategy->saveState());
+                checkpoint.put("config", config.describe());
+                checkpoint.put("trainer", std::to_string(completed) + " " + std::to_string(wins) + " " +
+                                          std::to_string(seed));
+                writer.submit(completed, std::move(checkpoint));
+                
+                // Print progress
+                double win_rate = static_cast<double>(wins) / completed;
+                std::cout << "Episode " << completed << ", Win rate: " << win_rate
+                          << ", epsilon: " << rlStrategy->getEpsilon() << std::endl;
+            }
         }
+        writer.flush();
+        
+        // Save final model
+        rlStrategy->saveModel("rl_model_final.dat");
+        
+        // Final stats
+        double final_win_rate = episodes > 0 ? static_cast<double>(wins) / episodes : 0.0;
+        std::cout << "Training complete. Final win rate: " << final_win_rate << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "[train_rl_strategy] " << e.what() << "\n";
+        return 1;
     }
     
-    // Save final model
-    rlStrategy->saveModel("rl_model_final.dat");
-    
-    // Final stats
-    double final_win_rate = static_cast<double>(wins) / EPISODES;
-    std::cout << "Training complete. Final win rate: " << final_win_rate << std::endl;
-    
     // Demonstrate the trained agent
     std::cout << "\nDemonstrating trained agent..." << std::endl;
     